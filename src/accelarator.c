@@ -40,7 +40,7 @@ static int configure ( Tcl_Interp *interp, GtkWidget *accelarator, GnoclOption o
 	if ( options[widgetIdx].status == GNOCL_STATUS_CHANGED )
 	{
 		GtkWidget *widget;
-		widget = gnoclGetWidgetFromName ( Tcl_GetString ( options[widgetIdx].val.obj ), interp );
+		widget = gnoclGetWidgetFromObj ( interp, options[widgetIdx].val.obj );
 		gtk_label_set_mnemonic_widget ( GTK_LABEL ( accelarator ), widget );
 		g_printf ( "widget changed %s\n", Tcl_GetString ( options[widgetIdx].val.obj ) );
 	}
@@ -616,7 +616,7 @@ static int pageCmd ( GtkAssistant *assistant, Tcl_Interp *interp, int objc, Tcl_
 					{
 						case ChildIdx:
 							{
-								GtkWidget *widget = gnoclGetWidgetFromName ( Tcl_GetString ( objv[i+1] ), interp  );
+								GtkWidget *widget = gnoclGetWidgetFromObj ( interp, objv[i+1] );
 								/* pack with expand, fill and no paddings */
 								gtk_box_pack_start ( page, widget, 1 , 1, 0 );
 								break;
@@ -837,7 +837,7 @@ int assistantFunc ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * con
 
 		case RemoveWidgetIdx:
 			{
-				GtkWidget *widget = gnoclGetWidgetFromName ( Tcl_GetString ( objv[2] ), interp );
+				GtkWidget *widget = gnoclGetWidgetFromObj ( interp, objv[2] );
 				gtk_assistant_remove_action_widget ( assistant, widget );
 				break;
 			}
@@ -847,7 +847,7 @@ int assistantFunc ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * con
 #ifdef DEBUG_ASSISTANT
 				g_print ( "args %d = 0 %s 1 %s 2 %s \n", objc, Tcl_GetString ( objv[0] ), Tcl_GetString ( objv[1] ), Tcl_GetString ( objv[2] )  );
 #endif
-				GtkWidget *widget = gnoclGetWidgetFromName ( Tcl_GetString ( objv[2] ), interp );
+				GtkWidget *widget = gnoclGetWidgetFromObj ( interp, objv[2] );
 				gtk_assistant_add_action_widget ( assistant, widget );
 				break;
 			}
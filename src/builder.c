@@ -18,6 +18,8 @@
             13/03/2010  Extended buffer command to include options
                 -container
                 -objects
+            2026-10     GType keyed dispatch table, widget commands created on
+                        first use through ::unknown (-lazy), file -objects
 
 **/
 #include "gnocl.h"
@@ -232,14 +234,15 @@ static void simpleDestroyFunc (
 
 
 /**
-/brief
+/brief    Create the widget command for a builder object whose type index is known.
 /author   William J Giddings
 /date     24-11-2009
+/note     2026-10 split out of setGtkWidgetFunc so that creation can be deferred.
 **/
-int setGtkWidgetFunc ( Tcl_Interp *interp, GtkWidget *widget, int idx, Tcl_Obj *resList , gchar *builderName, char *name )
+static int createWidgetCommand ( Tcl_Interp *interp, GtkWidget *widget, int idx, char *name )
 {
 #ifdef DEBUG_BUILDER
-	printf ( "setGtkWidgetFunc UI_name = %s, Gnocl_ame = %s\n", builderName, name );
+	printf ( "createWidgetCommand Gnocl_name = %s\n", name );
 #endif
 
 	Tcl_ObjCmdProc *proc;
@@ -888,14 +891,189 @@ int setGtkWidgetFunc ( Tcl_Interp *interp, GtkWidget *widget, int idx, Tcl_Obj *
 			}
 	}
 
+	return TCL_OK;
+}
+
+/* type index (plus one) of objects whose command has not been created yet */
+static GQuark pendingQuark = 0;
+
+/* memoised GType -> GtkTypes index, filled on the first sight of each type */
+static GHashTable *type2idx = NULL;
+
+/* chains ::unknown so that widget commands are created on first use */
+static const char unknownScript[] =
+	"if { [llength [info commands ::unknown]] } {\n"
+	"\trename ::unknown ::gnocl::_unknown\n"
+	"} else {\n"
+	"\tproc ::gnocl::_unknown { cmd args } {\n"
+	"\t\treturn -code error \"invalid command name \\\"$cmd\\\"\"\n"
+	"\t}\n"
+	"}\n"
+	"proc ::unknown { cmd args } {\n"
+	"\tif { [string match *_WID* $cmd] && [::gnocl::_materialize $cmd] } {\n"
+	"\t\treturn [uplevel 1 [linsert $args 0 $cmd]]\n"
+	"\t}\n"
+	"\treturn [uplevel 1 [linsert $args 0 ::gnocl::_unknown $cmd]]\n"
+	"}\n";
+
+/**
+/brief  Return the GtkTypes index for the type of obj, or -1 if gnocl has no command for it.
+/date   2026-10
+/note   Only the first object of each GType pays for the string search.
+        Objects that are not widgets, e.g. adjustments, list stores or cell
+        renderers, never get a command.
+**/
+static int getTypeIdx ( GObject *obj )
+{
+	GType type = G_OBJECT_TYPE ( obj );
+	gpointer val;
+
+	if ( !GTK_IS_WIDGET ( obj ) )
+	{
+		return -1;
+	}
+
+	if ( type2idx == NULL )
+	{
+		type2idx = g_hash_table_new ( g_direct_hash, g_direct_equal );
+	}
+
+	if ( !g_hash_table_lookup_extended ( type2idx, GSIZE_TO_POINTER ( type ), NULL, &val ) )
+	{
+		val = GINT_TO_POINTER ( compare ( ( char * ) g_type_name ( type ), GtkTypes ) );
+		g_hash_table_insert ( type2idx, GSIZE_TO_POINTER ( type ), val );
+	}
+
+	return GPOINTER_TO_INT ( val );
+}
+
+/**
+/brief  ::gnocl::_materialize name
+        Create the pending command of a lazily imported widget.
+        Returns 1 if a command was created, otherwise 0.
+/date   2026-10
+**/
+static int materializeCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	GtkWidget *widget;
+	const char *id;
+	gchar *full = NULL;
+	int idx = 0;
+
+	if ( objc != 2 )
+	{
+		Tcl_WrongNumArgs ( interp, 1, objv, "name" );
+		return TCL_ERROR;
+	}
+
+	id = Tcl_GetString ( objv[1] );
+
+	/* the registry only knows fully qualified names */
+	if ( strncmp ( id, "::", 2 ) != 0 )
+	{
+		id = full = g_strconcat ( "::", id, NULL );
+	}
+
+	widget = gnoclGetWidgetFromName ( id, NULL );
+	g_free ( full );
+
+	if ( widget != NULL )
+	{
+		idx = GPOINTER_TO_INT ( g_object_get_qdata ( G_OBJECT ( widget ), pendingQuark ) );
+	}
+
+	if ( idx == 0 )
+	{
+		Tcl_SetObjResult ( interp, Tcl_NewBooleanObj ( 0 ) );
+		return TCL_OK;
+	}
+
+	g_object_set_qdata ( G_OBJECT ( widget ), pendingQuark, NULL );
+
+	switch ( createWidgetCommand ( interp, widget, idx - 1, ( char * ) gnoclGetNameFromWidget ( widget ) ) )
+	{
+		case TCL_OK:
+			break;
+		case TCL_ERROR:
+			return TCL_ERROR;
+		default:
+			Tcl_SetObjResult ( interp, Tcl_NewBooleanObj ( 0 ) );
+			return TCL_OK;
+	}
+
+	Tcl_SetObjResult ( interp, Tcl_NewBooleanObj ( 1 ) );
+
+	return TCL_OK;
+}
+
+/**
+/brief  Install the ::unknown chain and ::gnocl::_materialize once per interpreter.
+/date   2026-10
+**/
+static int installLazyCommands ( Tcl_Interp *interp )
+{
+	Tcl_CmdInfo info;
+
+	if ( pendingQuark == 0 )
+	{
+		pendingQuark = g_quark_from_static_string ( "gnocl::builderIdx" );
+	}
+
+	if ( Tcl_GetCommandInfo ( interp, "::gnocl::_materialize", &info ) )
+	{
+		return TCL_OK;
+	}
+
+	Tcl_CreateObjCommand ( interp, "::gnocl::_materialize", materializeCmd, NULL, NULL );
+
+	return Tcl_Eval ( interp, unknownScript );
+}
+
+/**
+/brief   Register a builder object with gnocl and append "name builderName" to resList.
+/author  William J Giddings
+/date    24-11-2009
+/note    2026-10 with lazy set the widget command is only created when the
+         name is first called as a command, see materializeCmd.
+         Objects without a matching gnocl type are skipped, returns -1.
+**/
+int setGtkWidgetFunc ( Tcl_Interp *interp, GtkWidget *widget, int idx, Tcl_Obj *resList , gchar *builderName, int lazy )
+{
+	char *name;
+	Tcl_Obj *item;
+	int ret;
+
+	if ( idx < 0 )
+	{
+		return -1;
+	}
+
+	name = gnoclGetAutoWidgetId();
+
+	if ( lazy )
+	{
+		if ( installLazyCommands ( interp ) != TCL_OK )
+		{
+			g_free ( name );
+			return TCL_ERROR;
+		}
+
+		g_object_set_qdata ( G_OBJECT ( widget ), pendingQuark, GINT_TO_POINTER ( idx + 1 ) );
+	}
+
+	else if ( ( ret = createWidgetCommand ( interp, widget, idx, name ) ) != TCL_OK )
+	{
+		g_free ( name );
+		return ret;
+	}
+
 	/* perform the equivalent of gnoclRegisterWidget */
 	g_signal_connect_after ( G_OBJECT ( widget ), "destroy", G_CALLBACK ( simpleDestroyFunc ), interp );
 	gnoclMemNameAndWidget ( name, GTK_WIDGET ( widget ) );
 
-	gchar str[50];
-	sprintf ( str, "%s %s", name, builderName );
-
-	Tcl_ListObjAppendElement ( interp, resList, Tcl_NewStringObj ( str, -1 ) );
+	item = Tcl_NewStringObj ( name, -1 );
+	Tcl_AppendStringsToObj ( item, " ", builderName, ( char * ) NULL );
+	Tcl_ListObjAppendElement ( interp, resList, item );
 
 	return TCL_OK;
 }
@@ -939,22 +1117,6 @@ static void  getWidgetNames ( GSList *widgetList, GSList *widgetNames )
 
 }
 
-static GSList * getBuilderObjectNames ( GtkBuilder *builder )
-{
-
-	GSList *p = NULL;
-	GSList *namelist = NULL;
-	const gchar *name;
-
-	for ( p = ( GSList * ) gtk_builder_get_objects ( builder ); p != NULL; p = p->next )
-	{
-		name =  gtk_widget_get_name ( p->data );
-		namelist = g_slist_append ( namelist, ( gchar * ) name );
-	}
-
-	return namelist;
-}
-
 static void display_list ( GSList *list )
 {
 
@@ -1010,11 +1172,23 @@ int gnoclBuilderCmd (
 	static const char *cmds[] = { "file", "buffer", NULL };
 	enum optIdx { FileIdx, BufferIdx };
 	int idx;
+	int lazy = 1;
 
 
-// objc must be either 3 or 7
+	/* a trailing -lazy bool applies to both sub-commands */
+	if ( objc >= 5 && strcmp ( Tcl_GetString ( objv[objc-2] ), "-lazy" ) == 0 )
+	{
+		if ( Tcl_GetBooleanFromObj ( interp, objv[objc-1], &lazy ) != TCL_OK )
+		{
+			return TCL_ERROR;
+		}
 
-	if ( ( objc != 3 ) && ( objc != 7 ) )
+		objc -= 2;
+	}
+
+// objc must be either 3, 5 (file -objects) or 7
+
+	if ( ( objc != 3 ) && ( objc != 5 ) && ( objc != 7 ) )
 	{
 		Tcl_SetResult ( interp, "GNOCL ERROR: Wrong number of arguments.\n", TCL_STATIC );
 		return TCL_ERROR;
@@ -1030,14 +1204,56 @@ int gnoclBuilderCmd (
 	{
 		case FileIdx:
 			{
+				GError *err = NULL;
+				guint ok;
+
 #ifdef DEBUG_BUILDER
 				printf ( ".....load from file %s\n", Tcl_GetString ( objv[2] ) );
 #endif
-
-				sprintf ( str, "%s", Tcl_GetString ( objv[2] ) );
-				//GtkWidget  *window1 = NULL;
 				builder = gtk_builder_new ();
-				gtk_builder_add_from_file ( builder, Tcl_GetString ( objv[2] ), NULL );
+
+				if ( objc == 5 )
+				{
+					/* only build the named objects and their children */
+					int noIds;
+					const char **ids;
+
+					if ( strcmp ( Tcl_GetString ( objv[3] ), "-objects" ) != 0 )
+					{
+						Tcl_AppendResult ( interp, "GNOCL ERROR: Unknown option \"", Tcl_GetString ( objv[3] ), "\", must be -objects or -lazy.", ( char * ) NULL );
+						g_object_unref ( builder );
+						return TCL_ERROR;
+					}
+
+					if ( Tcl_SplitList ( interp, Tcl_GetString ( objv[4] ), &noIds, &ids ) != TCL_OK )
+					{
+						g_object_unref ( builder );
+						return TCL_ERROR;
+					}
+
+					ok = gtk_builder_add_objects_from_file ( builder, Tcl_GetString ( objv[2] ), ( gchar ** ) ids, &err );
+					Tcl_Free ( ( char * ) ids );
+				}
+
+				else if ( objc == 3 )
+				{
+					ok = gtk_builder_add_from_file ( builder, Tcl_GetString ( objv[2] ), &err );
+				}
+
+				else
+				{
+					Tcl_SetResult ( interp, "GNOCL ERROR: Wrong number of arguments.\n", TCL_STATIC );
+					g_object_unref ( builder );
+					return TCL_ERROR;
+				}
+
+				if ( ok == 0 )
+				{
+					Tcl_AppendResult ( interp, "GNOCL ERROR: ", err->message, ( char * ) NULL );
+					g_error_free ( err );
+					g_object_unref ( builder );
+					return TCL_ERROR;
+				}
 			}
 			break;
 		case BufferIdx:
@@ -1213,12 +1429,6 @@ int gnoclBuilderCmd (
 
 SwitchIdxEnd:
 
-	/* the convenience function left out of the basic set of library functions */
-	widgetNames = getBuilderObjectNames ( builder );
-#ifdef DEBUG_BUILDER
-	display_list ( widgetNames );
-#endif
-
 	GtkWidget *window;
 	GtkWidget *widget;
 
@@ -1226,30 +1436,36 @@ SwitchIdxEnd:
 	/*  build up a list of names */
 	Tcl_Obj *resList = Tcl_NewListObj ( 0, NULL );
 
-	/* ignore gnomeApp widgets, these are handled in their own modules */
-	for ( p = widgetNames; p != NULL; p = p->next )
-	{
-#ifdef DEBUG_BUILDER
-		printf ( "Now sorting out handler function for %s\n", p->data );
-#endif
-		/* obtain pointer to widget based upon list of names */
-		widget = gtk_builder_get_object ( builder, p->data );
+	/* walk the builder's own list once, the type table avoids any string compares */
+	objectList = gtk_builder_get_objects ( builder );
 
-		/* obtain a new gnocl name */
-		const char *name = gnoclGetAutoWidgetId();
+	for ( p = objectList; p != NULL; p = p->next )
+	{
+		/* not every builder object is a widget, so no checked cast yet */
+		widget = p->data;
 
 		gchar *type =  G_OBJECT_TYPE_NAME ( widget );
 
-#ifdef DEBUG_BUILDER == builder
-		printf ( "The gnocl name created is %s, type = %s\n", name, type );
-#endif
 		/* determine how to handle the new widget */
-		gint idx = compare ( type, GtkTypes );
-#ifdef DEBUG_BUILDER == builder
-		printf ( "The gnocl name created is %s, type = %s, idx = %d\n", name, type, idx );
+		gint idx = getTypeIdx ( G_OBJECT ( widget ) );
+
+		if ( idx < 0 )
+		{
+			continue;
+		}
+
+#ifdef DEBUG_BUILDER
+		printf ( "Now sorting out handler function for type = %s, idx = %d\n", type, idx );
 #endif
 		/* now, effectively a multi-widget gnoclRegisterWidget function */
-		setGtkWidgetFunc ( interp, widget, idx , resList, p->data, name );
+		if ( setGtkWidgetFunc ( interp, widget, idx , resList,
+								GTK_IS_BUILDABLE ( widget ) ? ( gchar * ) gtk_buildable_get_name ( GTK_BUILDABLE ( widget ) ) : "",
+								lazy ) == TCL_ERROR )
+		{
+			g_slist_free ( objectList );
+			Tcl_DecrRefCount ( resList );
+			return TCL_ERROR;
+		}
 
 		if ( 0 )
 		{
@@ -1349,6 +1565,8 @@ SwitchIdxEnd:
 
 	}
 
+	g_slist_free ( objectList );
+
 	/* create a specific command for each of the builder files loaded */
 	Tcl_CreateObjCommand ( interp, Tcl_GetString ( objv[2] ), builderFunc, builder, NULL );
 
@@ -1463,18 +1681,21 @@ int gnoclGladeCmd (
 
 		widget = GTK_WIDGET (  p->data );
 
-		const char *name = gnoclGetAutoWidgetId();
-
 		/* name and type, add to list */
 		gchar *gladeName = glade_get_widget_name ( widget );
 
 		gchar *type =  G_OBJECT_TYPE_NAME ( widget );
 
 		/* determine how to handle the new widget */
-		gint idx = compare ( type, GtkTypes );
+		gint idx = getTypeIdx ( G_OBJECT ( widget ) );
 
 		/* now, effectively a multi-widget gnoclRegisterWidget function */
-		setGtkWidgetFunc ( interp, widget, idx , resList, gladeName, name );
+		if ( setGtkWidgetFunc ( interp, widget, idx , resList, gladeName, 0 ) == TCL_ERROR )
+		{
+			g_list_free ( widgetList );
+			Tcl_DecrRefCount ( resList );
+			return TCL_ERROR;
+		}
 
 		if ( 0 )
 		{
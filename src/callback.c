@@ -52,6 +52,7 @@
 
 /*
    History:
+   2026-10: keyed tasks with -key, named -priority levels, configure -budget
    2003-03: begin of developement
 */
 
@@ -60,6 +61,38 @@
 #include <ctype.h>
 #include <assert.h>
 
+/* default time a task source may run per main loop iteration, in microseconds */
+#define TASK_BUDGET 8000
+
+/* a keyed callback, tasks of the same priority share one TaskSource */
+typedef struct
+{
+	gchar      *key;
+	Tcl_Interp *interp;
+	Tcl_Obj    *script;         /* keeps its byte code between runs */
+	gint       priority;
+	gint64     interval;        /* microseconds, 0 runs once when idle */
+	gint64     due;
+	int        running;
+	int        dead;            /* deleted or replaced while running */
+} Task;
+
+typedef struct
+{
+	GSource source;
+	GQueue  tasks;
+} TaskSource;
+
+static GHashTable *key2task = NULL;
+static GHashTable *priority2source = NULL;
+static gint64 taskBudget = TASK_BUDGET;
+
+static const char *priorityNames[] = { "beforeLayout", "beforeRedraw", "afterRedraw", "idle", NULL };
+static const gint priorityValues[] =
+{
+	GTK_PRIORITY_RESIZE - 1, GDK_PRIORITY_REDRAW - 1, GDK_PRIORITY_REDRAW + 1, G_PRIORITY_DEFAULT_IDLE
+};
+
 /****f* callback/doCommand
  * AUTHOR
  *	PGB
@@ -68,8 +101,21 @@
 static gboolean doCommand ( gpointer data )
 {
 	GnoclCommandData *cs = ( GnoclCommandData * ) data;
-	int ret = Tcl_EvalEx ( cs->interp, cs->command, -1,
-						   TCL_EVAL_GLOBAL | TCL_EVAL_DIRECT );
+	gint64 profStart;
+	GnoclProfileStat *profStat = gnoclProfiling ? gnoclProfileBegin ( GNOCL_PROFILE_CALLBACK, cs->command, &profStart ) : NULL;
+	int ret;
+
+	if ( gnoclFrameStats )
+		gnoclFramePush ( GNOCL_FRAME_IDLE );
+
+	ret = Tcl_EvalEx ( cs->interp, cs->command, -1,
+					   TCL_EVAL_GLOBAL | TCL_EVAL_DIRECT );
+
+	if ( gnoclFrameStats )
+		gnoclFramePop ();
+
+	if ( profStat != NULL )
+		gnoclProfileEnd ( profStat, profStart );
 
 	if ( ret == TCL_ERROR )
 		Tcl_BackgroundError ( cs->interp );
@@ -96,9 +142,294 @@ static void destroyCmd ( gpointer data )
 
 /*****/
 
+/****f* callback/taskFree
+ * CREATION DATE
+ *	2026-10
+ * SOURCE
+ */
+static void taskFree ( Task *task )
+{
+	Tcl_DecrRefCount ( task->script );
+	g_free ( task->key );
+	g_free ( task );
+}
+
+/*****/
+
+/****f* callback/taskRemove
+ * CREATION DATE
+ *	2026-10
+ * NOTES
+ *	A running task is only marked, taskSourceDispatch frees it afterwards.
+ * SOURCE
+ */
+static void taskRemove ( Task *task )
+{
+	TaskSource *ts = g_hash_table_lookup ( priority2source, GINT_TO_POINTER ( task->priority ) );
+
+	g_hash_table_remove ( key2task, task->key );
+	g_queue_remove ( &ts->tasks, task );
+
+	if ( task->running )
+		task->dead = 1;
+	else
+		taskFree ( task );
+}
+
+/*****/
+
+/****f* callback/taskFirstDue
+ * CREATION DATE
+ *	2026-10
+ * SOURCE
+ */
+static gint64 taskFirstDue ( TaskSource *ts )
+{
+	GList *p;
+	gint64 due = G_MAXINT64;
+
+	for ( p = ts->tasks.head; p != NULL; p = p->next )
+	{
+		Task *task = p->data;
+
+		if ( task->due < due )
+			due = task->due;
+	}
+
+	return due;
+}
+
+/*****/
+
+/****f* callback/taskSourcePrepare
+ * CREATION DATE
+ *	2026-10
+ * SOURCE
+ */
+static gboolean taskSourcePrepare ( GSource *source, gint *timeout )
+{
+	gint64 due = taskFirstDue ( ( TaskSource * ) source );
+	gint64 now;
+
+	if ( due == G_MAXINT64 )
+	{
+		*timeout = -1;
+		return FALSE;
+	}
+
+	now = gnoclMonotonicTime ();
+
+	if ( due <= now )
+	{
+		*timeout = 0;
+		return TRUE;
+	}
+
+	*timeout = ( gint ) MIN ( ( due - now + 999 ) / 1000, G_MAXINT );
+
+	return FALSE;
+}
+
+/*****/
+
+/****f* callback/taskSourceCheck
+ * CREATION DATE
+ *	2026-10
+ * SOURCE
+ */
+static gboolean taskSourceCheck ( GSource *source )
+{
+	return taskFirstDue ( ( TaskSource * ) source ) <= gnoclMonotonicTime ();
+}
+
+/*****/
+
+/****f* callback/taskRun
+ * CREATION DATE
+ *	2026-10
+ * SOURCE
+ */
+static void taskRun ( Task *task, gint64 now )
+{
+	gint64 profStart;
+	GnoclProfileStat *profStat = gnoclProfiling ? gnoclProfileBegin ( GNOCL_PROFILE_CALLBACK, task->key, &profStart ) : NULL;
+	int ret;
+
+	task->running = 1;
+
+	if ( gnoclFrameStats )
+		gnoclFramePush ( GNOCL_FRAME_IDLE );
+
+	ret = Tcl_EvalObjEx ( task->interp, task->script, TCL_EVAL_GLOBAL );
+
+	if ( gnoclFrameStats )
+		gnoclFramePop ();
+
+	if ( profStat != NULL )
+		gnoclProfileEnd ( profStat, profStart );
+
+	task->running = 0;
+
+	if ( ret == TCL_ERROR )
+		Tcl_BackgroundError ( task->interp );
+
+	if ( task->dead )
+	{
+		taskFree ( task );
+		return;
+	}
+
+	/* like other callbacks, periodic tasks end on break or error */
+	if ( task->interval == 0 || ret != TCL_OK )
+	{
+		taskRemove ( task );
+		return;
+	}
+
+	/* skip missed periods instead of running them in a burst */
+	task->due += task->interval;
+
+	if ( task->due < now )
+		task->due = now + task->interval;
+}
+
+/*****/
+
+/****f* callback/taskSourceDispatch
+ * CREATION DATE
+ *	2026-10
+ * NOTES
+ *	Runs the due tasks of one priority, oldest first, until the budget
+ *	is spent. The rest waits for the next main loop iteration so that
+ *	events and redraws are not starved.
+ * SOURCE
+ */
+static gboolean taskSourceDispatch ( GSource *source, GSourceFunc callback, gpointer data )
+{
+	TaskSource *ts = ( TaskSource * ) source;
+	gint64 start = gnoclMonotonicTime ();
+	gint64 now = start;
+
+	do
+	{
+		Task *best = NULL;
+		GList *p;
+
+		for ( p = ts->tasks.head; p != NULL; p = p->next )
+		{
+			Task *task = p->data;
+
+			if ( task->due <= now && ( best == NULL || task->due < best->due ) )
+				best = task;
+		}
+
+		if ( best == NULL )
+			break;
+
+		taskRun ( best, now );
+		now = gnoclMonotonicTime ();
+	}
+	while ( now - start < taskBudget );
+
+	return TRUE;
+}
+
+/*****/
+
+static GSourceFuncs taskSourceFuncs =
+{
+	taskSourcePrepare,
+	taskSourceCheck,
+	taskSourceDispatch,
+	NULL
+};
+
+/****f* callback/taskSchedule
+ * CREATION DATE
+ *	2026-10
+ * NOTES
+ *	Replaces a pending task with the same key, so repeated requests
+ *	for the same update run only once.
+ * SOURCE
+ */
+static void taskSchedule ( Tcl_Interp *interp, const char *key, Tcl_Obj *script,
+						   gint priority, int interval )
+{
+	TaskSource *ts;
+	Task *task;
+
+	if ( key2task == NULL )
+	{
+		key2task = g_hash_table_new ( g_str_hash, g_str_equal );
+		priority2source = g_hash_table_new ( g_direct_hash, g_direct_equal );
+	}
+
+	if ( ( task = g_hash_table_lookup ( key2task, key ) ) != NULL )
+		taskRemove ( task );
+
+	ts = g_hash_table_lookup ( priority2source, GINT_TO_POINTER ( priority ) );
+
+	if ( ts == NULL )
+	{
+		ts = ( TaskSource * ) g_source_new ( &taskSourceFuncs, sizeof ( TaskSource ) );
+		g_queue_init ( &ts->tasks );
+		g_source_set_priority ( &ts->source, priority );
+		g_source_attach ( &ts->source, NULL );
+		g_hash_table_insert ( priority2source, GINT_TO_POINTER ( priority ), ts );
+	}
+
+	task = g_new0 ( Task, 1 );
+	task->key = g_strdup ( key );
+	task->interp = interp;
+	task->script = Tcl_DuplicateObj ( script );
+	Tcl_IncrRefCount ( task->script );
+	task->priority = priority;
+	task->interval = interval > 0 ? ( gint64 ) interval * 1000 : 0;
+	task->due = gnoclMonotonicTime () + task->interval;
+
+	g_hash_table_insert ( key2task, task->key, task );
+	g_queue_push_tail ( &ts->tasks, task );
+}
+
+/*****/
+
+/****f* callback/getPriority
+ * CREATION DATE
+ *	2026-10
+ * NOTES
+ *	An integer is relative to the default idle priority as before,
+ *	a name places the callback around GTK's layout and redraw.
+ * SOURCE
+ */
+static int getPriority ( Tcl_Interp *interp, Tcl_Obj *obj, gint *priority )
+{
+	int idx;
+
+	if ( Tcl_GetIntFromObj ( NULL, obj, &idx ) == TCL_OK )
+	{
+		*priority = G_PRIORITY_DEFAULT_IDLE - idx;
+		return TCL_OK;
+	}
+
+	if ( Tcl_GetIndexFromObj ( interp, obj, priorityNames, "priority",
+							   TCL_EXACT, &idx ) != TCL_OK )
+		return TCL_ERROR;
+
+	*priority = priorityValues[idx];
+
+	return TCL_OK;
+}
+
+/*****/
+
 /****f* callback/create
  * AUTHOR
  *	PGB
+ * NOTES
+ *	With -key the script becomes a task of the shared scheduler and the
+ *	key is returned: creating the same key again replaces the pending
+ *	task, an idle task runs once, an -interval task repeats until it
+ *	returns a break or an error.
  * SOURCE
  */
 static int create ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
@@ -106,14 +437,16 @@ static int create ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 	GnoclOption options[] =
 	{
 		{ "-interval", GNOCL_OBJ, NULL },    /* 0 */
-		{ "-priority", GNOCL_INT, NULL },    /* 1 */
+		{ "-priority", GNOCL_OBJ, NULL },    /* 1 */
+		{ "-key", GNOCL_STRING, NULL },      /* 2 */
 		{ NULL }
 	};
 	const int intervalIdx = 0;
 	const int priorityIdx = 1;
+	const int keyIdx = 2;
 
 	int interval = -1;
-	int priority = 0;
+	gint priority = G_PRIORITY_DEFAULT_IDLE;
 	int id;
 	GnoclCommandData *cs;
 
@@ -126,10 +459,9 @@ static int create ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 	if ( gnoclParseOptions ( interp, objc - 2, objv + 2, options ) != TCL_OK )
 		goto errorExit;
 
-	if ( options[priorityIdx].status == GNOCL_STATUS_CHANGED )
-		priority = options[priorityIdx].val.i;
-
-	/* TODO? test priority range? */
+	if ( options[priorityIdx].status == GNOCL_STATUS_CHANGED
+			&& getPriority ( interp, options[priorityIdx].val.obj, &priority ) != TCL_OK )
+		goto errorExit;
 
 	if ( options[intervalIdx].status == GNOCL_STATUS_CHANGED )
 	{
@@ -155,6 +487,14 @@ static int create ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 
 	}
 
+	if ( options[keyIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		taskSchedule ( interp, options[keyIdx].val.str, objv[2], priority, interval );
+		Tcl_SetObjResult ( interp, Tcl_NewStringObj ( options[keyIdx].val.str, -1 ) );
+		gnoclClearOptions ( options );
+		return TCL_OK;
+	}
+
 	gnoclClearOptions ( options );
 
 	cs = g_new ( GnoclCommandData, 1 );
@@ -164,14 +504,12 @@ static int create ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 
 	if ( interval <= 0 ) /* idle */
 	{
-		id = g_idle_add_full ( G_PRIORITY_DEFAULT_IDLE - priority,
-							   doCommand, cs, destroyCmd );
+		id = g_idle_add_full ( priority, doCommand, cs, destroyCmd );
 	}
 
 	else
 	{
-		id = g_timeout_add_full ( G_PRIORITY_DEFAULT_IDLE - priority, interval,
-								  doCommand, cs, destroyCmd );
+		id = g_timeout_add_full ( priority, interval, doCommand, cs, destroyCmd );
 	}
 
 	Tcl_SetObjResult ( interp, Tcl_NewIntObj ( id ) );
@@ -196,13 +534,22 @@ static int delete ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 {
 	int      id;
 	gboolean removed;
+	Task     *task;
 
 	if ( objc < 3 )
 	{
-		Tcl_WrongNumArgs ( interp, 2, objv, "ID" );
+		Tcl_WrongNumArgs ( interp, 2, objv, "ID|key" );
 		return TCL_ERROR;
 	}
 
+	if ( key2task != NULL
+			&& ( task = g_hash_table_lookup ( key2task, Tcl_GetString ( objv[2] ) ) ) != NULL )
+	{
+		taskRemove ( task );
+		Tcl_SetObjResult ( interp, Tcl_NewIntObj ( 1 ) );
+		return TCL_OK;
+	}
+
 	if ( Tcl_GetIntFromObj ( interp, objv[2], &id ) != TCL_OK )
 		return TCL_ERROR;
 
@@ -215,6 +562,47 @@ static int delete ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 
 /*****/
 
+/****f* callback/configure
+ * CREATION DATE
+ *	2026-10
+ * SOURCE
+ */
+static int configure ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	GnoclOption options[] =
+	{
+		{ "-budget", GNOCL_INT, NULL },    /* 0 */
+		{ NULL }
+	};
+	const int budgetIdx = 0;
+	int ret = TCL_OK;
+
+	/* gnoclParseOptions skips its first argument */
+	if ( gnoclParseOptions ( interp, objc - 1, objv + 1, options ) != TCL_OK )
+	{
+		gnoclClearOptions ( options );
+		return TCL_ERROR;
+	}
+
+	if ( options[budgetIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		if ( options[budgetIdx].val.i <= 0 )
+		{
+			Tcl_SetResult ( interp, "budget must be greater zero.", TCL_STATIC );
+			ret = TCL_ERROR;
+		}
+
+		else
+			taskBudget = ( gint64 ) options[budgetIdx].val.i * 1000;
+	}
+
+	gnoclClearOptions ( options );
+
+	return ret;
+}
+
+/*****/
+
 /****f* callback/gnoclCallbackCmd
  * AUTHOR
  *	PGB
@@ -222,8 +610,8 @@ static int delete ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
  */
 int gnoclCallbackCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 {
-	static const char *cmds[] = { "create", "delete", NULL };
-	enum cmdIdx { CreateIdx, DeleteIdx };
+	static const char *cmds[] = { "create", "delete", "configure", NULL };
+	enum cmdIdx { CreateIdx, DeleteIdx, ConfigureIdx };
 	int idx;
 
 	if ( objc < 2 )
@@ -240,6 +628,7 @@ int gnoclCallbackCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj *
 	{
 		case CreateIdx: return create ( interp, objc, objv );
 		case DeleteIdx: return delete ( interp, objc, objv );
+		case ConfigureIdx: return configure ( interp, objc, objv );
 		default:  assert ( 0 );
 	}
 
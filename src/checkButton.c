@@ -128,6 +128,7 @@ static GnoclOption checkButtonOptions[] =
 	   { "-activeTextColor", GNOCL_OBJ, "active", gnoclOptGdkColorText },
 	   { "-prelightTextColor", GNOCL_OBJ, "prelight", gnoclOptGdkColorText },
 	*/
+	{ "-variableSync", GNOCL_OBJ, "", gnoclOptVariableSync },
 	{ NULL },
 };
 /*****/
@@ -347,7 +348,12 @@ char *gnoclCheckTraceFunc ( ClientData data, Tcl_Interp *interp, const char *nam
 
 	if ( para->inSetVar == 0 )
 	{
-		Tcl_Obj *val = Tcl_GetVar2Ex ( interp, name1, name2, flags );
+		Tcl_Obj *val;
+
+		if ( gnoclVarSyncDefer ( G_OBJECT ( para->widget ), gnoclCheckTraceFunc, data, interp, para->variable ) )
+			return NULL;
+
+		val = Tcl_GetVar2Ex ( interp, name1, name2, flags );
 
 		if ( val )
 		{
@@ -2,7 +2,8 @@
 \brief      This module implements the gnocl::comboBox widget.
              It implements both forms, ie GtkComboBox and the GtkComboBoxEntry
 \author    Peter G. Baum, William J Giddings
-\date       2010-10   added -widthChars
+\date       2026-10   value index, add and setItems
+            2010-10   added -widthChars
             2009-06   added -entryWidth
                             -heightRequest
             2009-02:  added -widthRequest
@@ -55,6 +56,8 @@
 /*
    History:
 
+*   2026-10   -completion options for comboEntry
+*   2026-10   value to row index, bulk add and setItems with detached model
 *   2010-10   added -widthChars
 *   2009-06   added -entryWidth
 *                   -heightRequest
@@ -97,6 +100,8 @@ typedef struct
 	char        *onChanged;
 	char        *variable;
 	int         inSetVar;
+	GHashTable  *index;     /* value -> row + 1, first row wins */
+	int         rows;
 } ComboParams;
 
 
@@ -158,6 +163,13 @@ GnoclOption comboBoxOptions[] =
 	{ "-onKeyRelease", GNOCL_OBJ, "", gnoclOptOnKeyRelease },
 
 	{ "-widthChars", GNOCL_INT, "width-chars" },
+	{ "-variableSync", GNOCL_OBJ, "", gnoclOptVariableSync },
+
+	/* comboEntry only, completion.c */
+	{ "-completion", GNOCL_OBJ, "", gnoclOptCompletion },
+	{ "-completionFile", GNOCL_OBJ, "", gnoclOptCompletionFile },
+	{ "-completionLimit", GNOCL_OBJ, "", gnoclOptCompletionLimit },
+	{ "-completionMatch", GNOCL_OBJ, "", gnoclOptCompletionMatch },
 
 	{ NULL },
 };
@@ -173,31 +185,11 @@ static GtkEntry *getEntry ( GtkComboBox *comboBox )
 
 /**
 \author     Peter G Baum
+\note       2026-10 looked up in para->index instead of walking the model
 **/
-static int findItemFromValue ( GtkComboBox *comboBox, const char *txt )
+static int findItemFromValue ( ComboParams *para, const char *txt )
 {
-	GtkTreeModel *model = gtk_combo_box_get_model ( comboBox );
-	int          row = -1;
-
-	if ( model )
-	{
-		GtkTreeIter  iter;
-		gboolean valid =  gtk_tree_model_get_iter_first ( model, &iter );
-
-		while ( valid )
-		{
-			const char *val;
-			++row;
-			gtk_tree_model_get ( model, &iter, VALUE_COLUMN, &val, -1 );
-
-			if ( strcmp ( txt, val ) == 0 )
-				break;
-
-			valid = gtk_tree_model_iter_next ( model, &iter );
-		}
-	}
-
-	return row;
+	return GPOINTER_TO_INT ( g_hash_table_lookup ( para->index, txt ) ) - 1;
 }
 
 /**
@@ -315,7 +307,7 @@ static int setState ( ComboParams *para, const char *val )
 
 	else
 	{
-		n = findItemFromValue ( para->comboBox, val );
+		n = findItemFromValue ( para, val );
 
 		if ( n >= 0 )
 		{
@@ -342,7 +334,12 @@ static char *traceFunc ( ClientData data, Tcl_Interp *interp, const char *name1,
 
 	if ( para->inSetVar == 0 && name1 )
 	{
-		const char *val = Tcl_GetVar2 ( interp, name1, name2, flags );
+		const char *val;
+
+		if ( gnoclVarSyncDefer ( G_OBJECT ( para->comboBox ), traceFunc, data, interp, para->variable ) )
+			return NULL;
+
+		val = Tcl_GetVar2 ( interp, name1, name2, flags );
 
 		if ( val )
 		{
@@ -368,6 +365,7 @@ static void destroyFunc ( GtkWidget *widget, gpointer data )
 	gnoclForgetWidgetFromName ( para->name );
 	Tcl_DeleteCommand ( para->interp, para->name );
 
+	g_hash_table_destroy ( para->index );
 	g_free ( para->variable );
 	g_free ( para->onChanged );
 	g_free ( para->name );
@@ -376,13 +374,20 @@ static void destroyFunc ( GtkWidget *widget, gpointer data )
 
 /**
 \author     Peter G Baum
+\note       2026-10 keeps para->index up to date
 **/
-static int addItem ( GtkTreeModel *model, const char *val, const char *txt )
+static int addItem ( ComboParams *para, GtkTreeModel *model, const char *val, const char *txt )
 {
 	GtkTreeIter iter;
-	gtk_list_store_append ( GTK_LIST_STORE ( model ), &iter );
-	gtk_list_store_set ( GTK_LIST_STORE ( model ), &iter,
-						 VALUE_COLUMN, val, TEXT_COLUMN, txt, -1 );
+	gtk_list_store_insert_with_values ( GTK_LIST_STORE ( model ), &iter, para->rows,
+										VALUE_COLUMN, val, TEXT_COLUMN, txt, -1 );
+
+	if ( g_hash_table_lookup ( para->index, val ) == NULL )
+	{
+		g_hash_table_insert ( para->index, g_strdup ( val ), GINT_TO_POINTER ( para->rows + 1 ) );
+	}
+
+	++para->rows;
 
 	return TCL_OK;
 }
@@ -390,11 +395,13 @@ static int addItem ( GtkTreeModel *model, const char *val, const char *txt )
 /**
 \author     Peter G Baum
 **/
-static int clearModel ( GtkComboBox *comboBox, GtkTreeModel *model )
+static int clearModel ( ComboParams *para, GtkTreeModel *model )
 {
-	GObject *sigObj = getSigObj ( comboBox );
+	GObject *sigObj = getSigObj ( para->comboBox );
 	int blocked = g_signal_handlers_block_matched ( sigObj, G_SIGNAL_MATCH_FUNC, 0, 0, NULL, ( void * ) changedFunc, NULL );
 	gtk_list_store_clear ( GTK_LIST_STORE ( model ) );
+	g_hash_table_remove_all ( para->index );
+	para->rows = 0;
 
 	if ( blocked )
 	{
@@ -404,6 +411,92 @@ static int clearModel ( GtkComboBox *comboBox, GtkTreeModel *model )
 	return 0;
 }
 
+/**
+\brief      Append items, or replace all of them, with the model detached
+            from the view so that it is not updated row by row.
+\date       2026-10
+\note       items is a list of texts, or with withValues of {text value}
+            pairs. The list is checked before the model is touched.
+            The active row is kept when appending, replace leaves it unset.
+**/
+static int loadItems ( Tcl_Interp *interp, ComboParams *para, Tcl_Obj *items,
+					   int withValues, int replace )
+{
+	GtkTreeModel *model = gtk_combo_box_get_model ( para->comboBox );
+	GObject *sigObj = getSigObj ( para->comboBox );
+	Tcl_Obj **elems;
+	int active = replace ? -1 : gtk_combo_box_get_active ( para->comboBox );
+	int blocked;
+	int no, k;
+
+	if ( Tcl_ListObjGetElements ( interp, items, &no, &elems ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( withValues )
+	{
+		for ( k = 0; k < no; ++k )
+		{
+			int len;
+
+			if ( Tcl_ListObjLength ( interp, elems[k], &len ) != TCL_OK )
+			{
+				return TCL_ERROR;
+			}
+
+			if ( len != 2 )
+			{
+				Tcl_AppendResult ( interp, "GNOCL ERROR: expected {text value} but got \"",
+								   Tcl_GetString ( elems[k] ), "\"", NULL );
+				return TCL_ERROR;
+			}
+		}
+	}
+
+	blocked = g_signal_handlers_block_matched ( sigObj, G_SIGNAL_MATCH_FUNC, 0, 0, NULL, ( void * ) changedFunc, NULL );
+
+	g_object_ref ( model );
+	gtk_combo_box_set_model ( para->comboBox, NULL );
+
+	if ( replace )
+	{
+		clearModel ( para, model );
+	}
+
+	for ( k = 0; k < no; ++k )
+	{
+		if ( withValues )
+		{
+			Tcl_Obj *txt, *val;
+
+			Tcl_ListObjIndex ( NULL, elems[k], 0, &txt );
+			Tcl_ListObjIndex ( NULL, elems[k], 1, &val );
+			addItem ( para, model, Tcl_GetString ( val ), Tcl_GetString ( txt ) );
+		}
+
+		else
+		{
+			addItem ( para, model, Tcl_GetString ( elems[k] ), Tcl_GetString ( elems[k] ) );
+		}
+	}
+
+	gtk_combo_box_set_model ( para->comboBox, model );
+	g_object_unref ( model );
+
+	if ( active >= 0 )
+	{
+		gtk_combo_box_set_active ( para->comboBox, active );
+	}
+
+	if ( blocked )
+	{
+		g_signal_handlers_unblock_matched ( sigObj, G_SIGNAL_MATCH_FUNC, 0, 0, NULL, ( void * ) changedFunc, NULL );
+	}
+
+	return TCL_OK;
+}
+
 /**
 \author     Peter G Baum
 **/
@@ -430,9 +523,6 @@ static int configure ( Tcl_Interp *interp, ComboParams *para, GnoclOption option
 
 	if ( options[itemsIdx].status == GNOCL_STATUS_CHANGED )
 	{
-		int     k, no;
-		Tcl_Obj *items = options[itemsIdx].val.obj;
-
 		if ( options[itemValueIdx].status == GNOCL_STATUS_CHANGED )
 		{
 			Tcl_SetResult ( interp,
@@ -441,57 +531,16 @@ static int configure ( Tcl_Interp *interp, ComboParams *para, GnoclOption option
 			return TCL_ERROR;
 		}
 
-		if ( Tcl_ListObjLength ( interp, items, &no ) != TCL_OK )
-		{
-			Tcl_SetResult ( interp, "items must be proper list",
-							TCL_STATIC );
+		if ( loadItems ( interp, para, options[itemsIdx].val.obj, 0, 1 ) != TCL_OK )
 			return TCL_ERROR;
-		}
-
-		clearModel ( para->comboBox, model );
-
-		for ( k = 0; k < no; ++k )
-		{
-			Tcl_Obj *tp;
-
-			if ( Tcl_ListObjIndex ( interp, items, k, &tp ) != TCL_OK )
-				return TCL_ERROR;
-
-			addItem ( model, Tcl_GetString ( tp ), Tcl_GetString ( tp ) );
-		}
 
 		setToFirst = 1;
 	}
 
 	if ( options[itemValueIdx].status == GNOCL_STATUS_CHANGED )
 	{
-		int     k, no;
-		Tcl_Obj *items = options[itemValueIdx].val.obj;
-
-		if ( Tcl_ListObjLength ( interp, items, &no ) != TCL_OK )
-		{
-			Tcl_SetResult ( interp, "itemValueList must be proper list",
-							TCL_STATIC );
+		if ( loadItems ( interp, para, options[itemValueIdx].val.obj, 1, 1 ) != TCL_OK )
 			return TCL_ERROR;
-		}
-
-		clearModel ( para->comboBox, model );
-
-		for ( k = 0; k < no; ++k )
-		{
-			Tcl_Obj *tp, *txt, *val;
-
-			if ( Tcl_ListObjIndex ( interp, items, k, &tp ) != TCL_OK )
-				return TCL_ERROR;
-
-			if ( Tcl_ListObjIndex ( interp, tp, 0, &txt ) != TCL_OK
-					|| Tcl_ListObjIndex ( interp, tp, 1, &val ) != TCL_OK )
-			{
-				return TCL_ERROR;
-			}
-
-			addItem ( model, Tcl_GetString ( val ) , Tcl_GetString ( txt ) );
-		}
 
 		setToFirst = 1;
 	}
@@ -627,20 +676,27 @@ static int cget ( Tcl_Interp *interp, ComboParams *para, GnoclOption options[],
 
 /**
 \author     Peter G Baum
+\note       2026-10 implemented: "add text ?-value val?" appends one item,
+            "add -items list" and "add -itemList list" append many at once.
 **/
 static int addItemTcl ( ComboParams *para, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 {
 	GnoclOption addOption[] =
 	{
-		{ "-value", GNOCL_OBJ, NULL },    /* 0 */
-		/* { "-icon", GNOCL_OBJ, NULL },     1 */
+		{ "-value", GNOCL_OBJ, NULL },      /* 0 */
+		{ "-items", GNOCL_OBJ, NULL },      /* 1 */
+		{ "-itemList", GNOCL_OBJ, NULL },   /* 2 */
+		/* { "-icon", GNOCL_OBJ, NULL },     3 */
 		{ NULL }
 	};
-	/* static const int addValueIdx = 0; */
+	static const int addValueIdx = 0;
+	static const int addItemsIdx = 1;
+	static const int addItemListIdx = 2;
 
-	int ret;
+	int ret = TCL_OK;
+	int bulk;
 
-	/* id add text ? opt ...? */
+	/* id add text ?opt val? | id add -items list | id add -itemList list */
 
 	if ( objc < 3 )
 	{
@@ -648,18 +704,153 @@ static int addItemTcl ( ComboParams *para, Tcl_Interp *interp, int objc, Tcl_Obj
 		return TCL_ERROR;
 	}
 
-	if ( gnoclParseOptions ( interp, objc - 2, objv + 2, addOption ) != TCL_OK )
+	bulk = strcmp ( Tcl_GetString ( objv[2] ), "-items" ) == 0
+		   || strcmp ( Tcl_GetString ( objv[2] ), "-itemList" ) == 0;
+
+	/* gnoclParseOptions skips the text, or the subcommand in the bulk form */
+	if ( gnoclParseOptions ( interp, objc - 2 + bulk, objv + 2 - bulk, addOption ) != TCL_OK )
 	{
 		gnoclClearOptions ( addOption );
 		return TCL_ERROR;
 	}
 
-#if 0
-	ret = addItem ( para, objv[2],
-					addOption[addValueIdx].status == GNOCL_STATUS_CHANGED ?
-					addOption[addValueIdx].val.obj : NULL );
+	if ( bulk )
+	{
+		if ( addOption[addValueIdx].status == GNOCL_STATUS_CHANGED
+				|| ( addOption[addItemsIdx].status == GNOCL_STATUS_CHANGED
+					 && addOption[addItemListIdx].status == GNOCL_STATUS_CHANGED ) )
+		{
+			Tcl_SetResult ( interp, "GNOCL ERROR: either -items or -itemList may be given.", TCL_STATIC );
+			ret = TCL_ERROR;
+		}
 
-#endif
+		else if ( addOption[addItemsIdx].status == GNOCL_STATUS_CHANGED )
+		{
+			ret = loadItems ( interp, para, addOption[addItemsIdx].val.obj, 0, 0 );
+		}
+
+		else
+		{
+			ret = loadItems ( interp, para, addOption[addItemListIdx].val.obj, 1, 0 );
+		}
+	}
+
+	else if ( addOption[addItemsIdx].status == GNOCL_STATUS_CHANGED
+			  || addOption[addItemListIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		Tcl_SetResult ( interp, "GNOCL ERROR: -items and -itemList replace the text argument.", TCL_STATIC );
+		ret = TCL_ERROR;
+	}
+
+	else
+	{
+		const char *txt = Tcl_GetString ( objv[2] );
+
+		addItem ( para, gtk_combo_box_get_model ( para->comboBox ),
+				  addOption[addValueIdx].status == GNOCL_STATUS_CHANGED ?
+				  Tcl_GetString ( addOption[addValueIdx].val.obj ) : txt, txt );
+	}
+
+	gnoclClearOptions ( addOption );
+
+	return ret;
+}
+
+/**
+\brief      "setItems list | setItems -items list | setItems -itemList list"
+            replaces all items at once.
+\date       2026-10
+\note       As with add and the widget options, -itemList takes {text value}
+            pairs. The current value stays selected if it is still an item,
+            otherwise the first item is, as with -items.
+**/
+static int setItemsTcl ( ComboParams *para, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	GnoclOption setOption[] =
+	{
+		{ "-items", GNOCL_OBJ, NULL },      /* 0 */
+		{ "-itemList", GNOCL_OBJ, NULL },   /* 1 */
+		{ NULL }
+	};
+	static const int setItemsIdx = 0;
+	static const int setItemListIdx = 1;
+
+	gchar *old = NULL;
+	const char *val = NULL;
+	Tcl_Obj *items;
+	int withValues = 0;
+	int ret;
+
+	if ( objc != 3 && objc != 4 )
+	{
+		Tcl_WrongNumArgs ( interp, 2, objv, "list | -items list | -itemList list" );
+		return TCL_ERROR;
+	}
+
+	if ( objc == 3 )
+	{
+		items = objv[2];
+	}
+
+	else
+	{
+		/* gnoclParseOptions skips the subcommand */
+		if ( gnoclParseOptions ( interp, objc - 1, objv + 1, setOption ) != TCL_OK )
+		{
+			gnoclClearOptions ( setOption );
+			return TCL_ERROR;
+		}
+
+		withValues = setOption[setItemListIdx].status == GNOCL_STATUS_CHANGED;
+		items = setOption[withValues ? setItemListIdx : setItemsIdx].val.obj;
+		Tcl_IncrRefCount ( items );
+		gnoclClearOptions ( setOption );
+	}
+
+	if ( !GTK_IS_COMBO_BOX_ENTRY ( para->comboBox ) )
+	{
+		old = g_strdup ( getActiveValue ( para->comboBox ) );
+	}
+
+	ret = loadItems ( interp, para, items, withValues, 1 );
+
+	if ( objc == 4 )
+	{
+		Tcl_DecrRefCount ( items );
+	}
+
+	if ( ret == TCL_OK && !GTK_IS_COMBO_BOX_ENTRY ( para->comboBox ) )
+	{
+		GtkTreeModel *model = gtk_combo_box_get_model ( para->comboBox );
+		GtkTreeIter iter;
+		gchar *first = NULL;
+
+		if ( old != NULL && findItemFromValue ( para, old ) >= 0 )
+		{
+			val = old;
+		}
+
+		else if ( gtk_tree_model_get_iter_first ( model, &iter ) )
+		{
+			gtk_tree_model_get ( model, &iter, VALUE_COLUMN, &first, -1 );
+			val = first;
+		}
+
+		if ( val != NULL )
+		{
+			setState ( para, val );
+
+			/* the variable only changes if the old value went away */
+			if ( val != old )
+			{
+				setVariable ( para, val );
+			}
+		}
+
+		g_free ( first );
+	}
+
+	g_free ( old );
 
 	return ret;
 }
@@ -669,9 +860,9 @@ static int addItemTcl ( ComboParams *para, Tcl_Interp *interp, int objc, Tcl_Obj
 **/
 int comboBoxFunc ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 {
-	static const char *cmds[] = { "delete", "configure", "cget", "add", "onChanged", "class", NULL
+	static const char *cmds[] = { "delete", "configure", "cget", "add", "setItems", "onChanged", "class", NULL
 								};
-	enum cmdIdx { DeleteIdx, ConfigureIdx, CgetIdx, AddIdx, DoOnChangedIdx, ClassIdx };
+	enum cmdIdx { DeleteIdx, ConfigureIdx, CgetIdx, AddIdx, SetItemsIdx, DoOnChangedIdx, ClassIdx };
 
 	ComboParams *para = ( ComboParams * ) data;
 	GtkWidget *widget = GTK_WIDGET ( para->comboBox );
@@ -730,6 +921,8 @@ int comboBoxFunc ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * cons
 
 		case AddIdx:
 			return addItemTcl ( para, interp, objc, objv );
+		case SetItemsIdx:
+			return setItemsTcl ( para, interp, objc, objv );
 		case DoOnChangedIdx:
 			{
 				const char *val;
@@ -781,6 +974,8 @@ static int makeComboBox ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[],
 						 isEntry ? gtk_combo_box_entry_new_with_model ( model, VALUE_COLUMN )
 						 : gtk_combo_box_new_with_model ( model ) );
 	para->inSetVar = 0;
+	para->index = g_hash_table_new_full ( g_str_hash, g_str_equal, g_free, NULL );
+	para->rows = 0;
 
 	/* excluded these operations if object is simply a GtkComboBox */
 	if ( isEntry == 0 )
@@ -805,6 +1000,7 @@ static int makeComboBox ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[],
 	if ( ret != TCL_OK )
 	{
 		gtk_widget_destroy ( GTK_WIDGET ( para->comboBox ) );
+		g_hash_table_destroy ( para->index );
 		g_free ( para );
 		return TCL_ERROR;
 	}
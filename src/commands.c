@@ -55,6 +55,11 @@
  * USED BY
  * MODIFICATION HISTORY
  *
+ *  2026-10: gnocl::build creates a widget tree from a nested spec
+ *  2026-10: gnoclSnapshotCmd renders widgets offscreen
+ *  2026-10: asynchronous clipboard queries
+ *  2026-10: gnocl::configure -variableSync, gnocl::info variableSync
+ *  2026-10: gnocl::update -idletasks, -budget and -redrawOnly
  *  2009-02: added gnoclResourceCmd
  *  2003-03: split from gnocl.c
  * TODO
@@ -101,7 +106,7 @@ int gnoclSignalStopCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj
 		return TCL_ERROR;
 	}
 
-	GtkWidget *widget = gnoclGetWidgetFromName (  Tcl_GetString ( objv[1] ), interp );
+	GtkWidget *widget = gnoclGetWidgetFromObj ( interp, objv[1] );
 
 	g_signal_stop_emission_by_name ( widget , Tcl_GetString ( objv[2] ) );
 	return TCL_OK;
@@ -157,7 +162,7 @@ int gnoclGrabCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * cons
 				GtkWidget *widget;
 				guint32 activate_time;
 
-				widget = gnoclGetWidgetFromName (  Tcl_GetString ( objv[2] ), interp );
+				widget = gnoclGetWidgetFromObj ( interp, objv[2] );
 
 				gdk_pointer_grab ( widget->window ,
 								   TRUE,
@@ -172,7 +177,7 @@ int gnoclGrabCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * cons
 				GtkWidget *widget;
 				guint32 activate_time;
 
-				widget = gnoclGetWidgetFromName (  Tcl_GetString ( objv[2] ), interp );
+				widget = gnoclGetWidgetFromObj ( interp, objv[2] );
 				gdk_keyboard_grab ( widget->window , TRUE, GDK_CURRENT_TIME );
 				break;
 			}
@@ -183,7 +188,7 @@ int gnoclGrabCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * cons
 				GtkWidget *widget;
 				guint32 activate_time;
 
-				widget = gnoclGetWidgetFromName (  Tcl_GetString ( objv[2] ), interp );
+				widget = gnoclGetWidgetFromObj ( interp, objv[2] );
 				gdk_display_pointer_ungrab ( gdk_drawable_get_display ( widget->window ), GDK_CURRENT_TIME );
 				gdk_keyboard_ungrab ( GDK_CURRENT_TIME );
 			}
@@ -355,26 +360,239 @@ int gnoclScreenCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * co
 
 // checking end
 
+static const int snapRectangleIdx = 0;
+static const int snapFileIdx = 1;
+static const int snapTypeIdx = 2;
+static const int snapPixBufIdx = 3;
+
+static GnoclOption snapshotOptions[] =
+{
+	{ "-rectangle", GNOCL_LIST, NULL },
+	{ "-file", GNOCL_STRING, NULL },
+	{ "-type", GNOCL_STRING, NULL },
+	{ "-pixBuf", GNOCL_BOOL, NULL },
+	{ NULL }
+};
+
 /**
-\brief      Return window/widget-related information
+\brief      Render a widget that is not on screen through a temporary offscreen window.
+\date       2026-10
+\note       The widget is put back into its old parent afterwards, which only
+            keeps its packing intact for single child containers. Only the
+            widget itself is shown for the snapshot, descendants hidden by
+            the application stay hidden.
+**/
+static GdkPixbuf *snapshotOffscreen ( GtkWidget *widget )
+{
+	GtkWidget *offscreen = gtk_offscreen_window_new ();
+	GtkWidget *parent = gtk_widget_get_parent ( widget );
+	gboolean visible = GTK_WIDGET_VISIBLE ( widget );
+	GdkPixbuf *pixbuf;
+
+	g_object_ref ( widget );
+
+	if ( parent != NULL )
+	{
+		gtk_container_remove ( GTK_CONTAINER ( parent ), widget );
+	}
+
+	gtk_container_add ( GTK_CONTAINER ( offscreen ), widget );
+	gtk_widget_show ( widget );
+	gtk_widget_show ( offscreen );
+
+	/* paint now rather than from the main loop */
+	gdk_window_process_updates ( offscreen->window, TRUE );
+	pixbuf = gtk_offscreen_window_get_pixbuf ( GTK_OFFSCREEN_WINDOW ( offscreen ) );
+
+	gtk_container_remove ( GTK_CONTAINER ( offscreen ), widget );
+	gtk_widget_destroy ( offscreen );
+
+	if ( !visible )
+	{
+		gtk_widget_hide ( widget );
+	}
+
+	if ( parent != NULL )
+	{
+		gtk_container_add ( GTK_CONTAINER ( parent ), widget );
+	}
+
+	g_object_unref ( widget );
+
+	return pixbuf;
+}
+
+/**
+\brief      Render a widget tree into a pixbuf without needing it to be visible.
+\date       2026-10
+\note       Mapped widgets are drawn with gtk_widget_get_snapshot, which also
+            works when they are obscured. Unparented widgets, and the child of
+            a window that is not shown, are rendered in an offscreen window,
+            so this works under Xvfb with nothing mapped at all.
+**/
+static GdkPixbuf *snapshotWidget ( Tcl_Interp *interp, GtkWidget *widget )
+{
+	GtkWidget *target = widget;
+
+	if ( GTK_WIDGET_MAPPED ( widget ) )
+	{
+		GdkPixmap *pixmap = gtk_widget_get_snapshot ( widget, NULL );
+		GdkPixbuf *pixbuf;
+		gint width, height;
+
+		if ( pixmap == NULL )
+		{
+			Tcl_SetResult ( interp, "GNOCL ERROR: Unable to draw widget.", TCL_STATIC );
+			return NULL;
+		}
+
+		gdk_drawable_get_size ( pixmap, &width, &height );
+		pixbuf = gdk_pixbuf_get_from_drawable ( NULL, pixmap, gtk_widget_get_colormap ( widget ),
+												0, 0, 0, 0, width, height );
+		g_object_unref ( pixmap );
+
+		return pixbuf;
+	}
+
+	if ( GTK_IS_WINDOW ( widget ) )
+	{
+		target = gtk_bin_get_child ( GTK_BIN ( widget ) );
+	}
+
+	else if ( gtk_widget_get_parent ( widget ) != NULL )
+	{
+		Tcl_SetResult ( interp, "GNOCL ERROR: Widget must be shown or have no parent.", TCL_STATIC );
+		return NULL;
+	}
+
+	if ( target == NULL )
+	{
+		Tcl_SetResult ( interp, "GNOCL ERROR: Window has nothing to draw.", TCL_STATIC );
+		return NULL;
+	}
+
+	return snapshotOffscreen ( target );
+}
+
+/**
+\brief      gnocl::snapshot widgetid ?-rectangle {x y w h}? ?-file name? ?-type png? ?-pixBuf bool?
+            Returns the id of a new pixbuf unless the image is written to -file.
 \author     William J Giddings
 \date       01-Mar-09
+\note       2026-10 implemented, see snapshotWidget.
 **/
 int gnoclSnapshotCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 {
+	GtkWidget *widget;
+	GdkPixbuf *pixbuf;
+	int ret = TCL_OK;
+	int keep;
 
 	if ( objc < 2 )
 	{
-		Tcl_WrongNumArgs ( interp, 1, objv, "snapshot widgetid -rectangle {x y w h}" );
+		Tcl_WrongNumArgs ( interp, 1, objv, "widgetid ?-rectangle {x y w h}? ?-file name? ?-type type? ?-pixBuf bool?" );
 		return TCL_ERROR;
 	}
 
-	GtkWidget *widget;
-	GdkRectangle *rect;
+	widget = gnoclGetWidgetFromObj ( interp, objv[1] );
+
+	if ( widget == NULL )
+	{
+		return TCL_ERROR;
+	}
 
-	widget = gnoclGetWidgetFromName (  Tcl_GetString ( objv[2] ), interp );
+	if ( gnoclParseOptions ( interp, objc - 1, objv + 1, snapshotOptions ) != TCL_OK )
+	{
+		gnoclClearOptions ( snapshotOptions );
+		return TCL_ERROR;
+	}
 
-	return TCL_OK;
+	pixbuf = snapshotWidget ( interp, widget );
+
+	if ( pixbuf == NULL )
+	{
+		gnoclClearOptions ( snapshotOptions );
+		return TCL_ERROR;
+	}
+
+	if ( snapshotOptions[snapRectangleIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		GdkRectangle all = { 0, 0, gdk_pixbuf_get_width ( pixbuf ), gdk_pixbuf_get_height ( pixbuf ) };
+		GdkRectangle rect;
+		GdkRectangle isect;
+		Tcl_Obj **elems;
+		int n;
+
+		if ( Tcl_ListObjGetElements ( interp, snapshotOptions[snapRectangleIdx].val.obj, &n, &elems ) != TCL_OK
+				|| n != 4
+				|| Tcl_GetIntFromObj ( interp, elems[0], &rect.x ) != TCL_OK
+				|| Tcl_GetIntFromObj ( interp, elems[1], &rect.y ) != TCL_OK
+				|| Tcl_GetIntFromObj ( interp, elems[2], &rect.width ) != TCL_OK
+				|| Tcl_GetIntFromObj ( interp, elems[3], &rect.height ) != TCL_OK )
+		{
+			Tcl_ResetResult ( interp );
+			Tcl_SetResult ( interp, "GNOCL ERROR: -rectangle must be a list {x y width height}.", TCL_STATIC );
+			ret = TCL_ERROR;
+		}
+
+		else if ( !gdk_rectangle_intersect ( &all, &rect, &isect ) )
+		{
+			Tcl_SetResult ( interp, "GNOCL ERROR: -rectangle lies outside the widget.", TCL_STATIC );
+			ret = TCL_ERROR;
+		}
+
+		else
+		{
+			GdkPixbuf *sub = gdk_pixbuf_new_subpixbuf ( pixbuf, isect.x, isect.y, isect.width, isect.height );
+
+			/* a sub pixbuf shares the pixels, copy so the full image can go */
+			GdkPixbuf *crop = gdk_pixbuf_copy ( sub );
+			g_object_unref ( sub );
+			g_object_unref ( pixbuf );
+			pixbuf = crop;
+		}
+	}
+
+	/* without -file the pixbuf is what the caller wants */
+	keep = snapshotOptions[snapFileIdx].status != GNOCL_STATUS_CHANGED;
+
+	if ( snapshotOptions[snapPixBufIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		keep = snapshotOptions[snapPixBufIdx].val.b;
+	}
+
+	if ( ret == TCL_OK && snapshotOptions[snapFileIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		GError *err = NULL;
+		const char *type = "png";
+
+		if ( snapshotOptions[snapTypeIdx].status == GNOCL_STATUS_CHANGED )
+		{
+			type = snapshotOptions[snapTypeIdx].val.str;
+		}
+
+		if ( !gdk_pixbuf_save ( pixbuf, snapshotOptions[snapFileIdx].val.str, type, &err, NULL ) )
+		{
+			Tcl_AppendResult ( interp, "GNOCL ERROR: ", err->message, ( char * ) NULL );
+			g_error_free ( err );
+			ret = TCL_ERROR;
+		}
+	}
+
+	if ( ret == TCL_OK && keep )
+	{
+		/* the registry takes over our reference */
+		ret = gnoclRegisterPixBuf ( interp, pixbuf, pixBufFunc );
+	}
+
+	else
+	{
+		g_object_unref ( pixbuf );
+	}
+
+	gnoclClearOptions ( snapshotOptions );
+
+	return ret;
 }
 
 
@@ -410,7 +628,7 @@ int gnoclWinfoCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * con
 		case ParentIdx:
 			{
 				char buffer[128];
-				GtkWidget *widget = gnoclGetWidgetFromName (  Tcl_GetString ( objv[2] ), interp );
+				GtkWidget *widget = gnoclGetWidgetFromObj ( interp, objv[2] );
 				GtkWidget *parent = gtk_widget_get_parent ( widget );
 
 				sprintf ( buffer, "%s", gnoclGetNameFromWidget ( parent ) );
@@ -421,7 +639,7 @@ int gnoclWinfoCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * con
 		case ToplevelIdx:
 			{
 				char buffer[128];
-				GtkWidget *widget = gnoclGetWidgetFromName (  Tcl_GetString ( objv[2] ), interp );
+				GtkWidget *widget = gnoclGetWidgetFromObj ( interp, objv[2] );
 				GtkWidget *toplevel = gtk_widget_get_toplevel ( widget );
 				sprintf ( buffer, "%s", gnoclGetNameFromWidget ( toplevel ) );
 				Tcl_SetObjResult ( interp, Tcl_NewStringObj ( buffer, -1 ) );
@@ -436,7 +654,7 @@ int gnoclWinfoCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * con
 				GtkRequisition req;
 				gint x, y;
 
-				widget = gnoclGetWidgetFromName (  Tcl_GetString ( objv[2] ), interp );
+				widget = gnoclGetWidgetFromObj ( interp, objv[2] );
 
 				gdk_window_get_origin ( widget->window, &x, &y );
 
@@ -474,10 +692,10 @@ int gnoclWinfoCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * con
 int gnoclInfoCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 {
 	static const char *cmd[] = { "version", "gtkVersion",
-								 "hasGnomeSupport", "allStockItems", "breakpoint", NULL
+								 "hasGnomeSupport", "allStockItems", "breakpoint", "variableSync", NULL
 							   };
 	enum optIdx { VersionIdx, GtkVersionIdx,
-				  HasGnomeIdx, AllStockItems, BreakpointIdx
+				  HasGnomeIdx, AllStockItems, BreakpointIdx, VariableSyncIdx
 				};
 	int idx;
 
@@ -585,32 +803,481 @@ int gnoclInfoCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * cons
 			/* this is only for debugging */
 			G_BREAKPOINT();
 			break;
+		case VariableSyncIdx:
+			Tcl_SetObjResult ( interp, gnoclVarSyncInfo () );
+			break;
 	}
 
 	return TCL_OK;
 }
 
+/* lay out the toplevels whose size changed, without running the resize idle */
+static void updateResize ( void )
+{
+	GList *toplevels = gtk_window_list_toplevels ();
+	GList *p;
+
+	for ( p = toplevels; p != NULL; p = p->next )
+	{
+		if ( GTK_WIDGET_VISIBLE ( p->data ) )
+		{
+			gtk_container_check_resize ( GTK_CONTAINER ( p->data ) );
+		}
+	}
+
+	g_list_free ( toplevels );
+}
+
 /**
+\brief      gnocl::update ?-idletasks? ?-budget ms? ?-redrawOnly?
+\date       2026-10
+\note       Returns the number of main loop iterations, or with -idletasks
+            the number of Tcl idle handlers, that ran.
+            -redrawOnly applies deferred variable writes and paints pending
+            exposes, no input is dispatched. -idletasks runs the Tcl idle
+            handlers first and lays out resized toplevels before painting.
+            Without -budget at most 500 iterations run, as before.
 **/
 int gnoclUpdateCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 {
+	static const char *opts[] = { "-idletasks", "-budget", "-redrawOnly", NULL };
+	enum optIdx { IdletasksIdx, BudgetIdx, RedrawOnlyIdx };
 	int nMax = 500;
-	int n;
+	int n = 0;
+	int idletasks = 0;
+	int redrawOnly = 0;
+	gint64 budget = -1;
+	gint64 start = 0;
+	int k;
+
+	for ( k = 1; k < objc; ++k )
+	{
+		int idx;
+
+		if ( Tcl_GetIndexFromObj ( interp, objv[k], opts, "option", TCL_EXACT, &idx ) != TCL_OK )
+		{
+			return TCL_ERROR;
+		}
+
+		switch ( idx )
+		{
+			case IdletasksIdx:
+				idletasks = 1;
+				break;
+			case RedrawOnlyIdx:
+				redrawOnly = 1;
+				break;
+			case BudgetIdx:
+				{
+					int ms;
+
+					if ( ++k == objc )
+					{
+						Tcl_WrongNumArgs ( interp, 1, objv, "?-idletasks? ?-budget ms? ?-redrawOnly?" );
+						return TCL_ERROR;
+					}
+
+					if ( Tcl_GetIntFromObj ( interp, objv[k], &ms ) != TCL_OK )
+					{
+						return TCL_ERROR;
+					}
+
+					if ( ms < 0 )
+					{
+						Tcl_SetResult ( interp, "GNOCL ERROR: -budget must not be negative.", TCL_STATIC );
+						return TCL_ERROR;
+					}
+
+					budget = ( gint64 ) ms * 1000;
+				}
+				break;
+		}
+	}
 
-	if ( objc != 1 )
+	if ( idletasks && redrawOnly )
 	{
-		Tcl_WrongNumArgs ( interp, 1, objv, NULL );
+		Tcl_SetResult ( interp, "GNOCL ERROR: -idletasks and -redrawOnly exclude each other.", TCL_STATIC );
 		return TCL_ERROR;
 	}
 
-	for ( n = 0; n < nMax && gtk_events_pending(); ++n )
-		gtk_main_iteration_do ( 0 );
+	if ( budget >= 0 )
+	{
+		start = gnoclMonotonicTime ();
+	}
+
+	if ( idletasks )
+	{
+		while ( ( budget < 0 || gnoclMonotonicTime () - start < budget )
+				&& Tcl_DoOneEvent ( TCL_IDLE_EVENTS | TCL_DONT_WAIT ) )
+		{
+			++n;
+		}
+	}
+
+	if ( idletasks || redrawOnly )
+	{
+		gnoclVarSyncFlush ();
+
+		if ( idletasks )
+		{
+			updateResize ();
+		}
+
+		gdk_window_process_all_updates ();
+	}
+
+	else
+	{
+		while ( ( budget >= 0 ? gnoclMonotonicTime () - start < budget : n < nMax ) && gtk_events_pending () )
+		{
+			gtk_main_iteration_do ( 0 );
+			++n;
+		}
+	}
 
 	Tcl_SetObjResult ( interp, Tcl_NewIntObj ( n ) );
 
 	return TCL_OK;
 }
 
+/* destroy what a failed gnocl::build left without a parent, newest first */
+static void buildDiscard ( Tcl_Obj *built )
+{
+	Tcl_Obj **names;
+	int n;
+
+	Tcl_ListObjGetElements ( NULL, built, &n, &names );
+
+	while ( n-- > 0 )
+	{
+		GtkWidget *widget = gnoclGetWidgetFromName ( Tcl_GetString ( names[n] ), NULL );
+
+		if ( widget != NULL && gtk_widget_get_parent ( widget ) == NULL )
+		{
+			gtk_widget_destroy ( widget );
+		}
+	}
+}
+
+/* how gnocl::build expands the child option of a widget type */
+enum BuildChildKind
+{
+	BUILD_LEAF,         /* no child option is expanded */
+	BUILD_CHILD,        /* -child is one spec */
+	BUILD_CHILDREN,     /* -children is a list of specs */
+	BUILD_PAGES         /* -children is a list of {spec label ?menu?} */
+};
+
+typedef struct
+{
+	const char *type;
+	enum BuildChildKind kind;
+} BuildType;
+
+/* widget creation commands gnocl::build may call */
+static const BuildType buildTypes[] =
+{
+	{ "arrowButton", BUILD_LEAF },
+	{ "box", BUILD_CHILDREN },
+	{ "button", BUILD_LEAF },
+	{ "calendar", BUILD_LEAF },
+	{ "checkButton", BUILD_LEAF },
+	{ "colorButton", BUILD_LEAF },
+	{ "colorSelection", BUILD_LEAF },
+	{ "colorWheel", BUILD_LEAF },
+	{ "combo", BUILD_LEAF },
+	{ "comboBox", BUILD_LEAF },
+	{ "comboEntry", BUILD_LEAF },
+	{ "curve", BUILD_LEAF },
+	{ "drawingArea", BUILD_LEAF },
+	{ "entry", BUILD_LEAF },
+	{ "eventBox", BUILD_CHILD },
+	{ "expander", BUILD_CHILD },
+	{ "fileChooser", BUILD_LEAF },
+	{ "fileChooserButton", BUILD_LEAF },
+	{ "folderChooserButton", BUILD_LEAF },
+	{ "fontButton", BUILD_LEAF },
+	{ "fontSelection", BUILD_LEAF },
+	{ "gammaCurve", BUILD_LEAF },
+	{ "handleBox", BUILD_CHILD },
+	{ "iconView", BUILD_LEAF },
+	{ "image", BUILD_LEAF },
+	{ "label", BUILD_LEAF },
+	{ "labelEntry", BUILD_LEAF },
+	{ "linkButton", BUILD_LEAF },
+	{ "list", BUILD_LEAF },
+	{ "menu", BUILD_CHILDREN },
+	{ "menuBar", BUILD_CHILDREN },
+	{ "menuCheckItem", BUILD_LEAF },
+	{ "menuItem", BUILD_LEAF },
+	{ "menuRadioItem", BUILD_LEAF },
+	{ "menuSeparator", BUILD_LEAF },
+	{ "notebook", BUILD_PAGES },
+	{ "optionMenu", BUILD_LEAF },
+	{ "paned", BUILD_CHILDREN },
+	{ "plug", BUILD_CHILD },
+	{ "progressBar", BUILD_LEAF },
+	{ "radioButton", BUILD_LEAF },
+	{ "recentChooser", BUILD_LEAF },
+	{ "ruler", BUILD_LEAF },
+	{ "scale", BUILD_LEAF },
+	{ "scaleButton", BUILD_LEAF },
+	{ "scrolledWindow", BUILD_CHILD },
+	{ "separator", BUILD_LEAF },
+	{ "socket", BUILD_LEAF },
+	{ "spinButton", BUILD_LEAF },
+	{ "statusBar", BUILD_LEAF },
+	{ "table", BUILD_LEAF },
+	{ "text", BUILD_LEAF },
+	{ "toggleButton", BUILD_LEAF },
+	{ "toolBar", BUILD_LEAF },
+	{ "tree", BUILD_LEAF },
+	{ "volumeButton", BUILD_LEAF },
+	{ "window", BUILD_CHILD },
+	{ NULL }
+};
+
+static int buildNode ( Tcl_Interp *interp, Tcl_Obj *spec, Tcl_Obj *built, Tcl_Obj **name );
+
+/**
+\brief      Build the specs in list and return the list with each spec
+            replaced by the name of its widget. With pages only the first
+            element of every item is a spec, the rest is passed on.
+\date       2026-10
+**/
+static int buildList ( Tcl_Interp *interp, Tcl_Obj *list, int pages, Tcl_Obj *built, Tcl_Obj **res )
+{
+	Tcl_Obj **items;
+	int m, i;
+
+	if ( Tcl_ListObjGetElements ( interp, list, &m, &items ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	*res = Tcl_NewListObj ( 0, NULL );
+	Tcl_IncrRefCount ( *res );
+
+	for ( i = 0; i < m; ++i )
+	{
+		Tcl_Obj *item = items[i];
+		Tcl_Obj *child;
+
+		if ( pages )
+		{
+			if ( Tcl_ListObjIndex ( interp, items[i], 0, &item ) != TCL_OK )
+			{
+				break;
+			}
+
+			if ( item == NULL )
+			{
+				Tcl_SetResult ( interp, "GNOCL ERROR: notebook page must be \"spec ?label? ?menu?\"", TCL_STATIC );
+				break;
+			}
+		}
+
+		if ( buildNode ( interp, item, built, &child ) != TCL_OK )
+		{
+			break;
+		}
+
+		if ( pages )
+		{
+			Tcl_Obj *page = Tcl_DuplicateObj ( items[i] );
+
+			Tcl_ListObjReplace ( NULL, page, 0, 1, 1, &child );
+			Tcl_ListObjAppendElement ( NULL, *res, page );
+		}
+
+		else
+		{
+			Tcl_ListObjAppendElement ( NULL, *res, child );
+		}
+
+		Tcl_DecrRefCount ( child );
+	}
+
+	if ( i < m )
+	{
+		Tcl_DecrRefCount ( *res );
+		return TCL_ERROR;
+	}
+
+	return TCL_OK;
+}
+
+/**
+\brief      Create the widget described by spec, children first.
+\date       2026-10
+\note       spec is {type ?option value ...?}, type one of buildTypes. For
+            containers the child option given there holds specs: -child a
+            single spec, -children a list of specs, or for a notebook a list
+            of pages whose first element is a spec. They are replaced by the
+            names of the widgets built from them before the creation command
+            of type is called directly, so the widget's own option table
+            handles the packing. Every widget created is appended to built.
+**/
+static int buildNode ( Tcl_Interp *interp, Tcl_Obj *spec, Tcl_Obj *built, Tcl_Obj **name )
+{
+	Tcl_CmdInfo info;
+	Tcl_Obj **elems;
+	Tcl_Obj **argv;
+	Tcl_Obj *cmd;
+	enum BuildChildKind kind;
+	int n, k, idx;
+	int ret = TCL_OK;
+
+	if ( Tcl_ListObjGetElements ( interp, spec, &n, &elems ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( n == 0 || n % 2 == 0 )
+	{
+		Tcl_ResetResult ( interp );
+		Tcl_AppendResult ( interp, "GNOCL ERROR: widget spec must be \"type ?option value ...?\", got \"",
+						   Tcl_GetString ( spec ), "\"", ( char * ) NULL );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_GetIndexFromObjStruct ( interp, elems[0], buildTypes, sizeof ( BuildType ),
+									 "widget type", TCL_EXACT, &idx ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	kind = buildTypes[idx].kind;
+
+	cmd = Tcl_NewStringObj ( "gnocl::", -1 );
+	Tcl_AppendObjToObj ( cmd, elems[0] );
+	Tcl_IncrRefCount ( cmd );
+
+	/* not registered with this gtk version */
+	if ( Tcl_GetCommandInfo ( interp, Tcl_GetString ( cmd ), &info ) == 0 || info.isNativeObjectProc == 0 )
+	{
+		Tcl_AppendResult ( interp, "GNOCL ERROR: unknown widget type \"",
+						   Tcl_GetString ( elems[0] ), "\"", ( char * ) NULL );
+		Tcl_DecrRefCount ( cmd );
+		return TCL_ERROR;
+	}
+
+	argv = ( Tcl_Obj ** ) ckalloc ( n * sizeof ( Tcl_Obj * ) );
+	argv[0] = cmd;
+
+	for ( k = 1; k < n; k += 2 )
+	{
+		const char *opt = Tcl_GetString ( elems[k] );
+
+		argv[k] = elems[k];
+		argv[k+1] = NULL;
+
+		if ( ret != TCL_OK )
+		{
+			continue;
+		}
+
+		if ( kind == BUILD_CHILD && strcmp ( opt, "-child" ) == 0 )
+		{
+			ret = buildNode ( interp, elems[k+1], built, &argv[k+1] );
+		}
+
+		else if ( ( kind == BUILD_CHILDREN || kind == BUILD_PAGES ) && strcmp ( opt, "-children" ) == 0 )
+		{
+			ret = buildList ( interp, elems[k+1], kind == BUILD_PAGES, built, &argv[k+1] );
+		}
+
+		else
+		{
+			argv[k+1] = elems[k+1];
+			Tcl_IncrRefCount ( argv[k+1] );
+		}
+	}
+
+	if ( ret == TCL_OK )
+	{
+		Tcl_ResetResult ( interp );
+		ret = info.objProc ( info.objClientData, interp, n, argv );
+	}
+
+	if ( ret == TCL_OK )
+	{
+		/* keep the name object itself, it caches the widget lookup */
+		*name = Tcl_GetObjResult ( interp );
+		Tcl_IncrRefCount ( *name );
+		Tcl_ResetResult ( interp );
+
+		if ( gnoclGetWidgetFromObj ( interp, *name ) == NULL )
+		{
+			Tcl_DecrRefCount ( *name );
+			ret = TCL_ERROR;
+		}
+
+		else
+		{
+			Tcl_ListObjAppendElement ( NULL, built, *name );
+		}
+	}
+
+	/* the option names are borrowed from spec, the rest is owned here */
+	for ( k = 0; k < n; k += 2 )
+	{
+		if ( argv[k] != NULL )
+		{
+			Tcl_DecrRefCount ( argv[k] );
+		}
+	}
+
+	ckfree ( ( char * ) argv );
+
+	return ret;
+}
+
+/**
+\brief      gnocl::build spec
+\date       2026-10
+\note       Builds a nested widget tree from one list, for example
+              gnocl::build {box -orientation vertical -children {
+                  {label -text a} {button -text b}}}
+            and returns the name of the outermost widget. Only the widget
+            types in buildTypes can be built. Children are
+            created before their parent, so a window at the root is only
+            mapped once the tree below it is complete. On error everything
+            built so far is destroyed again.
+**/
+int gnoclBuildCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	Tcl_Obj *built;
+	Tcl_Obj *name;
+	int ret;
+
+	if ( objc != 2 )
+	{
+		Tcl_WrongNumArgs ( interp, 1, objv, "spec" );
+		return TCL_ERROR;
+	}
+
+	built = Tcl_NewListObj ( 0, NULL );
+	Tcl_IncrRefCount ( built );
+
+	ret = buildNode ( interp, objv[1], built, &name );
+
+	if ( ret == TCL_OK )
+	{
+		Tcl_SetObjResult ( interp, name );
+		Tcl_DecrRefCount ( name );
+	}
+
+	else
+	{
+		buildDiscard ( built );
+	}
+
+	Tcl_DecrRefCount ( built );
+
+	return ret;
+}
+
 /**
 \brief      Load and configure widget styles using a resource (.rsc) file.
 \author     William j Giddings
@@ -654,10 +1321,12 @@ int gnoclConfigureCmd (
 	{
 		{ "-tooltip", GNOCL_BOOL, NULL },
 		{ "-defaultIcon", GNOCL_OBJ, NULL },
+		{ "-variableSync", GNOCL_OBJ, NULL },
 		{ NULL }
 	};
-	const int tooltipIdx     = 0;
-	const int defaultIconIdx = 1;
+	const int tooltipIdx      = 0;
+	const int defaultIconIdx  = 1;
+	const int variableSyncIdx = 2;
 
 	int ret = TCL_ERROR;
 
@@ -707,6 +1376,16 @@ int gnoclConfigureCmd (
 			gtk_tooltips_disable ( gnoclGetTooltips() );
 	}
 
+	if ( options[variableSyncIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		enum GnoclVarSync mode;
+
+		if ( gnoclGetVarSync ( interp, options[variableSyncIdx].val.obj, &mode ) != TCL_OK )
+			goto cleanExit;
+
+		gnoclSetVarSyncDefault ( mode );
+	}
+
 	ret = TCL_OK;
 
 cleanExit:
@@ -714,8 +1393,135 @@ cleanExit:
 	return ret;
 }
 
+/* a pending gtk_clipboard_request_* call */
+typedef struct
+{
+	Tcl_Interp *interp;
+	Tcl_Obj    *command;
+} ClipboardRequest;
+
+static ClipboardRequest *clipboardRequestNew ( Tcl_Interp *interp, Tcl_Obj *command )
+{
+	ClipboardRequest *req = g_new ( ClipboardRequest, 1 );
+
+	req->interp = interp;
+	req->command = command;
+	Tcl_IncrRefCount ( command );
+	Tcl_Preserve ( interp );
+
+	return req;
+}
+
+/**
+\brief      Call the -command prefix with result appended as one argument, then free req.
+\date       2026-10
+\note       The command is run as a list, not through percent substitution, so a
+            ByteArray result reaches the script without a string conversion.
+**/
+static void clipboardDeliver ( ClipboardRequest *req, Tcl_Obj *result )
+{
+	Tcl_Interp *interp = req->interp;
+
+	Tcl_IncrRefCount ( result );
+
+	if ( !Tcl_InterpDeleted ( interp ) )
+	{
+		Tcl_Obj *script = Tcl_DuplicateObj ( req->command );
+
+		Tcl_IncrRefCount ( script );
+
+		if ( Tcl_ListObjAppendElement ( interp, script, result ) != TCL_OK
+				|| Tcl_EvalObjEx ( interp, script, TCL_EVAL_GLOBAL ) != TCL_OK )
+		{
+			Tcl_BackgroundError ( interp );
+		}
+
+		Tcl_DecrRefCount ( script );
+	}
+
+	Tcl_DecrRefCount ( result );
+	Tcl_DecrRefCount ( req->command );
+	Tcl_Release ( interp );
+	g_free ( req );
+}
+
+static Tcl_Obj *clipboardTextObj ( const gchar *text )
+{
+	return Tcl_NewStringObj ( text != NULL ? text : "", -1 );
+}
+
+static Tcl_Obj *clipboardUrisObj ( gchar **uris )
+{
+	Tcl_Obj *list = Tcl_NewListObj ( 0, NULL );
+
+	for ( ; uris != NULL && *uris != NULL; uris++ )
+	{
+		Tcl_ListObjAppendElement ( NULL, list, Tcl_NewStringObj ( *uris, -1 ) );
+	}
+
+	return list;
+}
+
+static Tcl_Obj *clipboardContentsObj ( GtkSelectionData *sel )
+{
+	if ( sel == NULL || sel->length <= 0 )
+	{
+		return Tcl_NewByteArrayObj ( NULL, 0 );
+	}
+
+	return Tcl_NewByteArrayObj ( sel->data, sel->length );
+}
+
+/* registers a new reference to pixbuf and returns its id, the interpreter result is cleared */
+static Tcl_Obj *clipboardPixBufObj ( Tcl_Interp *interp, GdkPixbuf *pixbuf )
+{
+	Tcl_Obj *id;
+
+	if ( pixbuf == NULL )
+	{
+		return Tcl_NewObj ();
+	}
+
+	g_object_ref ( pixbuf );
+	gnoclRegisterPixBuf ( interp, pixbuf, pixBufFunc );
+	id = Tcl_DuplicateObj ( Tcl_GetObjResult ( interp ) );
+	Tcl_ResetResult ( interp );
+
+	return id;
+}
+
+static void clipboardTargetsReceived ( GtkClipboard *clip, GdkAtom *atoms, gint n, gpointer data )
+{
+	clipboardDeliver ( data, Tcl_NewBooleanObj ( atoms != NULL && gtk_targets_include_text ( atoms, n ) ) );
+}
+
+static void clipboardTextReceived ( GtkClipboard *clip, const gchar *text, gpointer data )
+{
+	clipboardDeliver ( data, clipboardTextObj ( text ) );
+}
+
+static void clipboardImageReceived ( GtkClipboard *clip, GdkPixbuf *pixbuf, gpointer data )
+{
+	ClipboardRequest *req = data;
+
+	clipboardDeliver ( req, clipboardPixBufObj ( req->interp, pixbuf ) );
+}
+
+static void clipboardUrisReceived ( GtkClipboard *clip, gchar **uris, gpointer data )
+{
+	clipboardDeliver ( data, clipboardUrisObj ( uris ) );
+}
+
+static void clipboardContentsReceived ( GtkClipboard *clip, GtkSelectionData *sel, gpointer data )
+{
+	clipboardDeliver ( data, clipboardContentsObj ( sel ) );
+}
+
 /**
 \author     Peter G. Baum
+\note       2026-10 with -command the hasText, getText, getImage, getUris and
+            getContents queries return at once and the command is called later
+            with the answer appended. getContents delivers a ByteArray.
 **/
 int gnoclClipboardCmd (
 	ClientData data,
@@ -726,18 +1532,24 @@ int gnoclClipboardCmd (
 	GnoclOption options[] =
 	{
 		{ "-primary", GNOCL_BOOL, NULL },
+		{ "-command", GNOCL_OBJ, NULL },
 		{ NULL }
 	};
 	const int usePrimaryIdx = 0;
+	const int commandIdx = 1;
 
 	static const char *cmd[] = { "hasText", "setText", "getText", "clear",
+								 "getImage", "getUris", "getContents",
 								 NULL
 							   };
-	enum optIdx { HasTextIdx, SetTextIdx, GetTextIdx, ClearIdx };
+	enum optIdx { HasTextIdx, SetTextIdx, GetTextIdx, ClearIdx,
+				  GetImageIdx, GetUrisIdx, GetContentsIdx
+				};
 	int idx;
 	int optNum;
 	GtkClipboard *clip;
 	int usePrimary = 0;
+	ClipboardRequest *req = NULL;
 
 	if ( objc < 2 )
 	{
@@ -749,13 +1561,13 @@ int gnoclClipboardCmd (
 							   &idx ) != TCL_OK )
 		return TCL_ERROR;
 
-	if ( idx == SetTextIdx )
+	if ( idx == SetTextIdx || idx == GetContentsIdx )
 	{
 		optNum = 2;
 
 		if ( objc < 3 )
 		{
-			Tcl_WrongNumArgs ( interp, 1, objv, "text ?option value?" );
+			Tcl_WrongNumArgs ( interp, 2, objv, idx == SetTextIdx ? "text ?option value?" : "target ?option value?" );
 			return TCL_ERROR;
 		}
 	}
@@ -773,17 +1585,41 @@ int gnoclClipboardCmd (
 
 	if ( gnoclParseOptions ( interp, objc - optNum, objv + optNum, options )
 			!= TCL_OK )
+	{
+		gnoclClearOptions ( options );
 		return TCL_ERROR;
+	}
 
 	if ( options[usePrimaryIdx].status == GNOCL_STATUS_CHANGED )
 		usePrimary = options[usePrimaryIdx].val.b;
 
+	if ( options[commandIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		if ( idx == SetTextIdx || idx == ClearIdx )
+		{
+			Tcl_SetResult ( interp, "GNOCL ERROR: -command is only valid for queries.", TCL_STATIC );
+			gnoclClearOptions ( options );
+			return TCL_ERROR;
+		}
+
+		req = clipboardRequestNew ( interp, options[commandIdx].val.obj );
+	}
+
+	gnoclClearOptions ( options );
+
 	clip = gtk_clipboard_get ( usePrimary ? gdk_atom_intern ( "PRIMARY", 1 )
 							   : GDK_NONE );
 
 	switch ( idx )
 	{
 		case HasTextIdx:
+
+			if ( req != NULL )
+			{
+				gtk_clipboard_request_targets ( clip, clipboardTargetsReceived, req );
+			}
+
+			else
 			{
 				int ret = gtk_clipboard_wait_is_text_available ( clip );
 				Tcl_SetObjResult ( interp, Tcl_NewBooleanObj ( ret ) );
@@ -794,6 +1630,13 @@ int gnoclClipboardCmd (
 			gtk_clipboard_set_text ( clip, Tcl_GetString ( objv[2] ), -1 );
 			break;
 		case GetTextIdx:
+
+			if ( req != NULL )
+			{
+				gtk_clipboard_request_text ( clip, clipboardTextReceived, req );
+			}
+
+			else
 			{
 				char *txt = gtk_clipboard_wait_for_text ( clip );
 
@@ -809,6 +1652,64 @@ int gnoclClipboardCmd (
 			break;
 		case ClearIdx:
 			gtk_clipboard_clear ( clip );
+			break;
+		case GetImageIdx:
+
+			if ( req != NULL )
+			{
+				gtk_clipboard_request_image ( clip, clipboardImageReceived, req );
+			}
+
+			else
+			{
+				GdkPixbuf *pixbuf = gtk_clipboard_wait_for_image ( clip );
+				Tcl_Obj *id = clipboardPixBufObj ( interp, pixbuf );
+
+				if ( pixbuf != NULL )
+				{
+					g_object_unref ( pixbuf );
+				}
+
+				Tcl_SetObjResult ( interp, id );
+			}
+
+			break;
+		case GetUrisIdx:
+
+			if ( req != NULL )
+			{
+				gtk_clipboard_request_uris ( clip, clipboardUrisReceived, req );
+			}
+
+			else
+			{
+				gchar **uris = gtk_clipboard_wait_for_uris ( clip );
+				Tcl_SetObjResult ( interp, clipboardUrisObj ( uris ) );
+				g_strfreev ( uris );
+			}
+
+			break;
+		case GetContentsIdx:
+			{
+				GdkAtom target = gdk_atom_intern ( Tcl_GetString ( objv[2] ), 0 );
+
+				if ( req != NULL )
+				{
+					gtk_clipboard_request_contents ( clip, target, clipboardContentsReceived, req );
+				}
+
+				else
+				{
+					GtkSelectionData *sel = gtk_clipboard_wait_for_contents ( clip, target );
+					Tcl_SetObjResult ( interp, clipboardContentsObj ( sel ) );
+
+					if ( sel != NULL )
+					{
+						gtk_selection_data_free ( sel );
+					}
+				}
+			}
+
 			break;
 	}
 
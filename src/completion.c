@@ -0,0 +1,664 @@
+/**
+**/
+
+/*
+ * This file implements a Tcl interface to GTK+ and Gnome
+ *
+ * See the file "license.terms" for information on usage and redistribution
+ * of this file, and for a DISCLAIMER OF ALL WARRANTIES.
+ *
+ */
+
+/*
+   History:
+   2026-10: begin of developement, -completion, -completionFile,
+            -completionMatch and -completionLimit for entry and comboEntry
+*/
+
+/**
+\page page_completion Completion
+\section sec_completion Description
+	Type-ahead completion over large word lists for gnocl::entry and
+	gnocl::comboEntry, shown in the popup of a GtkEntryCompletion:
+	<ul>
+	<li>-completion list : the words to complete from, "" removes completion</li>
+	<li>-completionFile path : the words, one per line</li>
+	<li>-completionMatch prefix|substring : default prefix</li>
+	<li>-completionLimit n : at most n suggestions, default 50</li>
+	</ul>
+	Words are kept sorted in one block of memory. Prefix lookups are a
+	binary search. Substring lookups start from the trigram posting list
+	of the query's rarest trigram, and narrow the previous match set while
+	characters are appended. Suggestions with the query as prefix come
+	first. Matching is case sensitive.
+\code
+	gnocl::entry -completionFile /usr/share/dict/words -completionMatch substring
+\endcode
+**/
+
+#include "gnocl.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define COMPLETION_LIMIT 50
+
+typedef struct
+{
+	gchar              *buffer;     /* all words, NUL separated */
+	gchar              **words;     /* sorted, point into buffer */
+	guint              n;
+	GHashTable         *trigrams;   /* trigram -> GArray of word indices */
+	int                substring;
+	guint              limit;
+	gchar              *query;      /* last substring query and its complete match set */
+	GArray             *matches;
+	GtkListStore       *store;
+	GtkEntryCompletion *completion;
+} Completion;
+
+static const char *completionKey = "gnocl::completion";
+
+/* the entry of an entry or comboEntry */
+static GtkEntry *completionEntry ( Tcl_Interp *interp, GObject *obj )
+{
+	if ( GTK_IS_ENTRY ( obj ) )
+	{
+		return GTK_ENTRY ( obj );
+	}
+
+	if ( GTK_IS_COMBO_BOX_ENTRY ( obj ) )
+	{
+		return GTK_ENTRY ( GTK_BIN ( obj )->child );
+	}
+
+	Tcl_SetResult ( interp, "GNOCL ERROR: completion is only available for entry and comboEntry.", TCL_STATIC );
+
+	return NULL;
+}
+
+static void completionFreeTrigram ( gpointer data )
+{
+	g_array_free ( data, TRUE );
+}
+
+/* forget the words, keep widget and settings */
+static void completionClearWords ( Completion *c )
+{
+	g_free ( c->buffer );
+	g_free ( c->words );
+	c->buffer = NULL;
+	c->words = NULL;
+	c->n = 0;
+
+	if ( c->trigrams != NULL )
+	{
+		g_hash_table_destroy ( c->trigrams );
+		c->trigrams = NULL;
+	}
+
+	g_free ( c->query );
+	c->query = NULL;
+	g_array_set_size ( c->matches, 0 );
+}
+
+static void completionFree ( gpointer data )
+{
+	Completion *c = data;
+
+	completionClearWords ( c );
+	g_array_free ( c->matches, TRUE );
+	g_object_unref ( c->completion );
+	g_object_unref ( c->store );
+	g_free ( c );
+}
+
+static int compareWords ( const void *a, const void *b )
+{
+	return strcmp ( * ( const gchar * const * ) a, * ( const gchar * const * ) b );
+}
+
+static guint32 trigramKey ( const gchar *s )
+{
+	return ( ( guint32 ) ( guchar ) s[0] << 16 ) | ( ( guint32 ) ( guchar ) s[1] << 8 ) | ( guchar ) s[2];
+}
+
+/**
+\brief      Posting lists of every byte trigram, built with the words while
+            -completionMatch is substring so that no keystroke pays for it.
+\date       2026-10
+**/
+static void completionBuildTrigrams ( Completion *c )
+{
+	guint k;
+
+	c->trigrams = g_hash_table_new_full ( g_direct_hash, g_direct_equal, NULL, completionFreeTrigram );
+
+	for ( k = 0; k < c->n; ++k )
+	{
+		const gchar *s;
+
+		for ( s = c->words[k]; s[0] && s[1] && s[2]; ++s )
+		{
+			gpointer key = GUINT_TO_POINTER ( trigramKey ( s ) );
+			GArray *list = g_hash_table_lookup ( c->trigrams, key );
+
+			if ( list == NULL )
+			{
+				list = g_array_new ( FALSE, FALSE, sizeof ( guint ) );
+				g_hash_table_insert ( c->trigrams, key, list );
+			}
+
+			/* a word repeating a trigram is listed once */
+			if ( list->len == 0 || g_array_index ( list, guint, list->len - 1 ) != k )
+			{
+				g_array_append_val ( list, k );
+			}
+		}
+	}
+}
+
+/**
+\brief      Sort the words of buffer, n NUL terminated strings, and drop duplicates.
+\date       2026-10
+**/
+static void completionSetWords ( Completion *c, gchar *buffer, guint n )
+{
+	gchar *p = buffer;
+	guint k, m;
+
+	completionClearWords ( c );
+
+	c->buffer = buffer;
+	c->words = g_new ( gchar *, n + 1 );
+
+	for ( k = 0; k < n; ++k )
+	{
+		c->words[k] = p;
+		p += strlen ( p ) + 1;
+	}
+
+	qsort ( c->words, n, sizeof ( gchar * ), compareWords );
+
+	for ( k = m = 0; k < n; ++k )
+	{
+		if ( m == 0 || strcmp ( c->words[m - 1], c->words[k] ) != 0 )
+		{
+			c->words[m++] = c->words[k];
+		}
+	}
+
+	c->words[m] = NULL;
+	c->n = m;
+
+	if ( c->substring )
+	{
+		completionBuildTrigrams ( c );
+	}
+}
+
+static void completionAppend ( Completion *c, const gchar *word )
+{
+	GtkTreeIter iter;
+
+	gtk_list_store_insert_with_values ( c->store, &iter, G_MAXINT, 0, word, -1 );
+}
+
+/* words starting with query are adjacent in the sorted array, [*first, *last) */
+static void completionPrefixRange ( Completion *c, const gchar *query, guint *first, guint *last )
+{
+	size_t len = strlen ( query );
+	guint lo = 0;
+	guint hi = c->n;
+
+	while ( lo < hi )
+	{
+		guint mid = lo + ( hi - lo ) / 2;
+
+		if ( strcmp ( c->words[mid], query ) < 0 )
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	*first = lo;
+	hi = c->n;
+
+	while ( lo < hi )
+	{
+		guint mid = lo + ( hi - lo ) / 2;
+
+		if ( strncmp ( c->words[mid], query, len ) <= 0 )
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	*last = lo;
+}
+
+static void completionPrefix ( Completion *c, const gchar *query )
+{
+	guint k, last;
+	guint found = 0;
+
+	completionPrefixRange ( c, query, &k, &last );
+
+	for ( ; k < last && found < c->limit; ++k, ++found )
+	{
+		completionAppend ( c, c->words[k] );
+	}
+}
+
+/**
+\brief      Fill the store with the words containing query, prefix matches first.
+\date       2026-10
+\note       Queries shorter than a trigram match too many words to be worth
+            keeping. Their prefix hits come from the sorted range, only the
+            other words are scanned until the limit is reached.
+**/
+static void completionSubstring ( Completion *c, const gchar *query )
+{
+	size_t len = strlen ( query );
+	GArray *matches;
+	guint found = 0;
+	guint k;
+
+	if ( len < 3 )
+	{
+		guint first, last;
+
+		completionPrefixRange ( c, query, &first, &last );
+
+		for ( k = first; k < last && found < c->limit; ++k, ++found )
+		{
+			completionAppend ( c, c->words[k] );
+		}
+
+		for ( k = 0; k < c->n && found < c->limit; ++k )
+		{
+			if ( k == first )
+			{
+				k = last;
+
+				if ( k == c->n )
+					break;
+			}
+
+			if ( strstr ( c->words[k], query ) != NULL )
+			{
+				completionAppend ( c, c->words[k] );
+				++found;
+			}
+		}
+
+		return;
+	}
+
+	matches = g_array_new ( FALSE, FALSE, sizeof ( guint ) );
+
+	if ( c->query != NULL && strstr ( query, c->query ) != NULL )
+	{
+		/* every word containing query contains the previous query */
+		for ( k = 0; k < c->matches->len; ++k )
+		{
+			guint w = g_array_index ( c->matches, guint, k );
+
+			if ( strstr ( c->words[w], query ) != NULL )
+				g_array_append_val ( matches, w );
+		}
+	}
+
+	else
+	{
+		GArray *rarest = NULL;
+		const gchar *s;
+
+		/* without words there is no index */
+		for ( s = query; c->trigrams != NULL && s[2]; ++s )
+		{
+			GArray *list = g_hash_table_lookup ( c->trigrams, GUINT_TO_POINTER ( trigramKey ( s ) ) );
+
+			if ( list == NULL || rarest == NULL || list->len < rarest->len )
+			{
+				rarest = list;
+			}
+
+			if ( rarest == NULL )
+			{
+				break;
+			}
+		}
+
+		for ( k = 0; rarest != NULL && k < rarest->len; ++k )
+		{
+			guint w = g_array_index ( rarest, guint, k );
+
+			if ( strstr ( c->words[w], query ) != NULL )
+				g_array_append_val ( matches, w );
+		}
+	}
+
+	g_free ( c->query );
+	g_array_free ( c->matches, TRUE );
+	c->query = g_strdup ( query );
+	c->matches = matches;
+
+	for ( k = 0; k < matches->len && found < c->limit; ++k )
+	{
+		const gchar *word = c->words[g_array_index ( matches, guint, k )];
+
+		if ( strncmp ( word, query, len ) == 0 )
+		{
+			completionAppend ( c, word );
+			++found;
+		}
+	}
+
+	for ( k = 0; k < matches->len && found < c->limit; ++k )
+	{
+		const gchar *word = c->words[g_array_index ( matches, guint, k )];
+
+		if ( strncmp ( word, query, len ) != 0 )
+		{
+			completionAppend ( c, word );
+			++found;
+		}
+	}
+}
+
+/* connected before GtkEntryCompletion's own handler, which then shows the store */
+static void completionChanged ( GtkEditable *editable, gpointer data )
+{
+	Completion *c = data;
+	const gchar *query = gtk_entry_get_text ( GTK_ENTRY ( editable ) );
+
+	gtk_list_store_clear ( c->store );
+
+	if ( *query == '\0' || c->n == 0 )
+	{
+		return;
+	}
+
+	if ( c->substring )
+		completionSubstring ( c, query );
+	else
+		completionPrefix ( c, query );
+}
+
+/* the store holds the matches already */
+static gboolean completionMatch ( GtkEntryCompletion *completion, const gchar *key,
+								  GtkTreeIter *iter, gpointer data )
+{
+	return TRUE;
+}
+
+static Completion *completionGet ( GtkEntry *entry )
+{
+	Completion *c = g_object_get_data ( G_OBJECT ( entry ), completionKey );
+
+	if ( c != NULL )
+	{
+		return c;
+	}
+
+	c = g_new0 ( Completion, 1 );
+	c->limit = COMPLETION_LIMIT;
+	c->matches = g_array_new ( FALSE, FALSE, sizeof ( guint ) );
+	c->store = gtk_list_store_new ( 1, G_TYPE_STRING );
+	c->completion = gtk_entry_completion_new ();
+
+	gtk_entry_completion_set_model ( c->completion, GTK_TREE_MODEL ( c->store ) );
+	gtk_entry_completion_set_text_column ( c->completion, 0 );
+	gtk_entry_completion_set_match_func ( c->completion, completionMatch, NULL, NULL );
+
+	g_signal_connect ( entry, "changed", G_CALLBACK ( completionChanged ), c );
+	gtk_entry_set_completion ( entry, c->completion );
+
+	g_object_set_data_full ( G_OBJECT ( entry ), completionKey, c, completionFree );
+
+	return c;
+}
+
+static void completionRemove ( GtkEntry *entry )
+{
+	Completion *c = g_object_get_data ( G_OBJECT ( entry ), completionKey );
+
+	if ( c == NULL )
+	{
+		return;
+	}
+
+	g_signal_handlers_disconnect_by_func ( entry, G_CALLBACK ( completionChanged ), c );
+	gtk_entry_set_completion ( entry, NULL );
+	g_object_set_data ( G_OBJECT ( entry ), completionKey, NULL );
+}
+
+/**
+\brief      -completion list
+\date       2026-10
+**/
+int gnoclOptCompletion ( Tcl_Interp *interp, GnoclOption *opt, GObject *obj, Tcl_Obj **ret )
+{
+	GtkEntry *entry = completionEntry ( interp, obj );
+	Completion *c;
+
+	if ( entry == NULL )
+	{
+		return TCL_ERROR;
+	}
+
+	c = g_object_get_data ( G_OBJECT ( entry ), completionKey );
+
+	if ( ret == NULL ) /* set value */
+	{
+		Tcl_Obj **elems;
+		gchar *buffer, *p;
+		size_t size = 0;
+		int no, k;
+
+		if ( Tcl_ListObjGetElements ( interp, opt->val.obj, &no, &elems ) != TCL_OK )
+		{
+			return TCL_ERROR;
+		}
+
+		if ( no == 0 )
+		{
+			completionRemove ( entry );
+			return TCL_OK;
+		}
+
+		for ( k = 0; k < no; ++k )
+		{
+			int len;
+
+			Tcl_GetStringFromObj ( elems[k], &len );
+			size += len + 1;
+		}
+
+		p = buffer = g_malloc ( size );
+
+		for ( k = 0; k < no; ++k )
+		{
+			int len;
+			const char *word = Tcl_GetStringFromObj ( elems[k], &len );
+
+			memcpy ( p, word, len + 1 );
+			p += len + 1;
+		}
+
+		completionSetWords ( completionGet ( entry ), buffer, no );
+	}
+
+	else /* get value */
+	{
+		guint k;
+
+		*ret = Tcl_NewListObj ( 0, NULL );
+
+		for ( k = 0; c != NULL && k < c->n; ++k )
+		{
+			Tcl_ListObjAppendElement ( NULL, *ret, Tcl_NewStringObj ( c->words[k], -1 ) );
+		}
+	}
+
+	return TCL_OK;
+}
+
+/**
+\brief      -completionFile path, one word per line
+\date       2026-10
+**/
+int gnoclOptCompletionFile ( Tcl_Interp *interp, GnoclOption *opt, GObject *obj, Tcl_Obj **ret )
+{
+	GtkEntry *entry = completionEntry ( interp, obj );
+	GError *error = NULL;
+	gchar *buffer, *p, *q;
+	gsize size;
+	guint n = 0;
+
+	if ( entry == NULL )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( ret != NULL )
+	{
+		return gnoclCgetNotImplemented ( interp, opt );
+	}
+
+	if ( !g_file_get_contents ( Tcl_GetString ( opt->val.obj ), &buffer, &size, &error ) )
+	{
+		Tcl_AppendResult ( interp, "GNOCL ERROR: ", error->message, ( char * ) NULL );
+		g_error_free ( error );
+		return TCL_ERROR;
+	}
+
+	if ( !g_utf8_validate ( buffer, size, NULL ) )
+	{
+		Tcl_AppendResult ( interp, "GNOCL ERROR: \"", Tcl_GetString ( opt->val.obj ),
+						   "\" is not UTF-8.", ( char * ) NULL );
+		g_free ( buffer );
+		return TCL_ERROR;
+	}
+
+	/* compact the lines in place into NUL separated words */
+	for ( p = q = buffer; p < buffer + size; )
+	{
+		gchar *end = memchr ( p, '\n', buffer + size - p );
+		gsize len;
+
+		if ( end == NULL )
+			end = buffer + size;
+
+		len = end - p;
+
+		if ( len > 0 && p[len - 1] == '\r' )
+			--len;
+
+		if ( len > 0 )
+		{
+			memmove ( q, p, len );
+			q[len] = '\0';
+			q += len + 1;
+			++n;
+		}
+
+		p = end + 1;
+	}
+
+	if ( n == 0 )
+	{
+		g_free ( buffer );
+		completionRemove ( entry );
+		return TCL_OK;
+	}
+
+	completionSetWords ( completionGet ( entry ), buffer, n );
+
+	return TCL_OK;
+}
+
+/**
+\brief      -completionMatch prefix|substring
+\date       2026-10
+**/
+int gnoclOptCompletionMatch ( Tcl_Interp *interp, GnoclOption *opt, GObject *obj, Tcl_Obj **ret )
+{
+	static const char *modes[] = { "prefix", "substring", NULL };
+	GtkEntry *entry = completionEntry ( interp, obj );
+	Completion *c;
+	int idx;
+
+	if ( entry == NULL )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( ret != NULL )
+	{
+		c = g_object_get_data ( G_OBJECT ( entry ), completionKey );
+
+		*ret = Tcl_NewStringObj ( modes[c != NULL && c->substring], -1 );
+		return TCL_OK;
+	}
+
+	if ( Tcl_GetIndexFromObj ( interp, opt->val.obj, modes, "match", TCL_EXACT, &idx ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	c = completionGet ( entry );
+	c->substring = idx;
+
+	/* index the words now rather than on the next keystroke */
+	if ( c->substring && c->trigrams == NULL && c->words != NULL )
+	{
+		completionBuildTrigrams ( c );
+	}
+
+	else if ( !c->substring && c->trigrams != NULL )
+	{
+		g_hash_table_destroy ( c->trigrams );
+		c->trigrams = NULL;
+	}
+
+	return TCL_OK;
+}
+
+/**
+\brief      -completionLimit n
+\date       2026-10
+**/
+int gnoclOptCompletionLimit ( Tcl_Interp *interp, GnoclOption *opt, GObject *obj, Tcl_Obj **ret )
+{
+	GtkEntry *entry = completionEntry ( interp, obj );
+	int limit;
+
+	if ( entry == NULL )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( ret != NULL )
+	{
+		Completion *c = g_object_get_data ( G_OBJECT ( entry ), completionKey );
+
+		*ret = Tcl_NewIntObj ( c != NULL ? c->limit : COMPLETION_LIMIT );
+		return TCL_OK;
+	}
+
+	if ( Tcl_GetIntFromObj ( interp, opt->val.obj, &limit ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( limit <= 0 )
+	{
+		Tcl_SetResult ( interp, "GNOCL ERROR: -completionLimit must be greater zero.", TCL_STATIC );
+		return TCL_ERROR;
+	}
+
+	completionGet ( entry )->limit = limit;
+
+	return TCL_OK;
+}
@@ -15,6 +15,8 @@
 
 /*
    History:
+   2026-10: profile start|stop|report
+   2026-10: frameStats start|stop|get
    2005-02: begin of developement
 */
 
@@ -22,18 +24,937 @@
 #include <string.h>
 #include <ctype.h>
 
+/* durations are histogrammed in powers of two microseconds, the last bucket takes the rest */
+#define PROFILE_BUCKETS    20
+#define PROFILE_TRACE_SIZE 65536
+
+#define FRAME_STACK        16
+#define FRAME_SIZE         256
+#define FRAME_THRESHOLD    50
+
+struct GnoclProfileStat
+{
+	gchar                 *key;
+	enum GnoclProfileKind kind;
+	struct ProfileData    *owner;
+	guint                 count;
+	gint64                total;
+	gint64                max;
+	guint                 histogram[PROFILE_BUCKETS];
+};
+
+/* one entry of the trace ring */
+typedef struct
+{
+	GnoclProfileStat *stat;
+	gint64           start;
+	gint64           duration;
+} ProfileEvent;
+
+/* one main loop iteration, from poll return to the next poll */
+typedef struct
+{
+	gint64      time;
+	gint64      busy;
+	gint64      spent[GNOCL_FRAME_KINDS];
+	const gchar *script;        /* slowest script, a profile stat key */
+	gint64      scriptTime;
+} FrameSample;
+
+/* main loop monitor, see gnocl::debug frameStats */
+typedef struct
+{
+	int         active;
+	int         open;
+	gint64      threshold;
+	gint64      origin;
+	GPollFunc   poll;
+	FrameSample current;
+	gint64      mark;
+	int         stack[FRAME_STACK];
+	int         depth;
+	guint       iterations;
+	gint64      busy;
+	gint64      max;
+	gint64      spent[GNOCL_FRAME_KINDS];
+	FrameSample *ring;
+	guint       size;
+	guint       stalls;
+} FrameData;
+
+/* per thread profile, from Tcl_GetThreadData; stats are never freed so that
+   pointers held across a running script stay valid */
+typedef struct ProfileData
+{
+	FrameData    frame;
+	int          active;
+	Tcl_Interp   *interp;
+	GHashTable   *stats[GNOCL_PROFILE_KINDS];
+	GHashTable   *wraps;
+	ProfileEvent *trace;
+	guint        traceSize;
+	guint        traceCount;
+	gint64       origin;
+} ProfileData;
+
+/* a widget command whose dispatch is timed */
+typedef struct
+{
+	Tcl_ObjCmdProc    *proc;
+	ClientData        clientData;
+	Tcl_CmdDeleteProc *deleteProc;
+	ClientData        deleteData;
+	GnoclProfileStat  *stat;
+	ProfileData       *owner;
+	gchar             *name;
+} ProfileWrap;
+
+static const char *profileKinds[] = { "scripts", "callbacks", "widgets" };
+static const char *frameKinds[] = { "events", "paint", "tcl", "idle", "other" };
+
+static Tcl_ThreadDataKey profileKey;
+
+/* number of running profiles and frame monitors, lets the hooks skip all work otherwise */
+int gnoclProfiling = 0;
+
+/* number of running frame monitors */
+int gnoclFrameStats = 0;
+
+static ProfileData *profileData ( void )
+{
+	return Tcl_GetThreadData ( &profileKey, sizeof ( ProfileData ) );
+}
+
+static GnoclProfileStat *profileStat ( ProfileData *data, enum GnoclProfileKind kind, const char *key )
+{
+	GnoclProfileStat *stat;
+	int k;
+
+	if ( data->stats[kind] == NULL )
+	{
+		for ( k = 0; k < GNOCL_PROFILE_KINDS; k++ )
+		{
+			data->stats[k] = g_hash_table_new ( g_str_hash, g_str_equal );
+		}
+	}
+
+	stat = g_hash_table_lookup ( data->stats[kind], key );
+
+	if ( stat == NULL )
+	{
+		stat = g_new0 ( GnoclProfileStat, 1 );
+		stat->key = g_strdup ( key );
+		stat->kind = kind;
+		stat->owner = data;
+		g_hash_table_insert ( data->stats[kind], stat->key, stat );
+	}
+
+	return stat;
+}
+
+/**
+\brief      Start timing one call, returns NULL unless this thread is profiling
+            or monitoring its main loop.
+\date       2026-10
+\note       Look the stat up before running the script, key may not survive it.
+**/
+GnoclProfileStat *gnoclProfileBegin ( enum GnoclProfileKind kind, const char *key, gint64 *start )
+{
+	ProfileData *data = profileData ();
+
+	if ( !data->active && !data->frame.active )
+	{
+		return NULL;
+	}
+
+	*start = gnoclMonotonicTime ();
+
+	return profileStat ( data, kind, key );
+}
+
+/**
+\brief      Account a call started with gnoclProfileBegin.
+\date       2026-10
+**/
+void gnoclProfileEnd ( GnoclProfileStat *stat, gint64 start )
+{
+	ProfileData *data = stat->owner;
+	gint64 duration = gnoclMonotonicTime () - start;
+	ProfileEvent *ev;
+	gint64 us;
+	int bucket = 0;
+
+	/* remember what kept this main loop iteration busy */
+	if ( data->frame.open && duration > data->frame.current.scriptTime )
+	{
+		data->frame.current.script = stat->key;
+		data->frame.current.scriptTime = duration;
+	}
+
+	/* stopped from within the script */
+	if ( !data->active )
+	{
+		return;
+	}
+
+	stat->count++;
+	stat->total += duration;
+
+	if ( duration > stat->max )
+	{
+		stat->max = duration;
+	}
+
+	for ( us = duration; us > 1 && bucket < PROFILE_BUCKETS - 1; us >>= 1 )
+	{
+		bucket++;
+	}
+
+	stat->histogram[bucket]++;
+
+	ev = data->trace + data->traceCount++ % data->traceSize;
+	ev->stat = stat;
+	ev->start = start;
+	ev->duration = duration;
+}
+
+/**
+\brief      Times a wrapped widget command.
+\date       2026-10
+**/
+static int profileTrampoline ( ClientData cd, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	ProfileWrap *wrap = cd;
+
+	/* the wrap is freed if the command deletes its own widget */
+	GnoclProfileStat *stat = wrap->stat;
+	gint64 start = gnoclMonotonicTime ();
+	int ret = wrap->proc ( wrap->clientData, interp, objc, objv );
+
+	gnoclProfileEnd ( stat, start );
+
+	return ret;
+}
+
+static void profileWrapFree ( gpointer p )
+{
+	ProfileWrap *wrap = p;
+
+	g_free ( wrap->name );
+	g_free ( wrap );
+}
+
+static void profileWrapDeleted ( ClientData cd )
+{
+	ProfileWrap *wrap = cd;
+
+	if ( wrap->deleteProc != NULL )
+	{
+		wrap->deleteProc ( wrap->deleteData );
+	}
+
+	g_hash_table_remove ( wrap->owner->wraps, wrap->name );
+}
+
+/**
+\brief      Route the widget command name through profileTrampoline while profiling.
+\date       2026-10
+**/
+void gnoclProfileWrapCommand ( Tcl_Interp *interp, const char *name )
+{
+	ProfileData *data = profileData ();
+	ProfileWrap *wrap;
+	Tcl_CmdInfo info;
+
+	if ( !data->active || data->interp != interp
+			|| !Tcl_GetCommandInfo ( interp, name, &info )
+			|| !info.isNativeObjectProc || info.objProc == profileTrampoline )
+	{
+		return;
+	}
+
+	wrap = g_new ( ProfileWrap, 1 );
+	wrap->proc = info.objProc;
+	wrap->clientData = info.objClientData;
+	wrap->deleteProc = info.deleteProc;
+	wrap->deleteData = info.deleteData;
+	wrap->stat = profileStat ( data, GNOCL_PROFILE_WIDGET, name );
+	wrap->owner = data;
+	wrap->name = g_strdup ( name );
+
+	info.objProc = profileTrampoline;
+	info.objClientData = wrap;
+	info.deleteProc = profileWrapDeleted;
+	info.deleteData = wrap;
+	Tcl_SetCommandInfo ( interp, name, &info );
+
+	g_hash_table_insert ( data->wraps, wrap->name, wrap );
+}
+
+static void profileWrapWidget ( gpointer key, gpointer value, gpointer user_data )
+{
+	ProfileData *data = user_data;
+	const char *name = gnoclGetNameFromWidget ( GTK_WIDGET ( value ) );
+
+	if ( name != NULL )
+	{
+		gnoclProfileWrapCommand ( data->interp, name );
+	}
+}
+
+static gboolean profileUnwrap ( gpointer key, gpointer value, gpointer user_data )
+{
+	ProfileWrap *wrap = value;
+	Tcl_Interp *interp = user_data;
+	Tcl_CmdInfo info;
+
+	if ( Tcl_GetCommandInfo ( interp, wrap->name, &info ) && info.objClientData == wrap )
+	{
+		info.objProc = wrap->proc;
+		info.objClientData = wrap->clientData;
+		info.deleteProc = wrap->deleteProc;
+		info.deleteData = wrap->deleteData;
+		Tcl_SetCommandInfo ( interp, wrap->name, &info );
+	}
+
+	return TRUE;
+}
+
+static void profileClearStat ( gpointer key, gpointer value, gpointer user_data )
+{
+	GnoclProfileStat *stat = value;
+
+	stat->count = 0;
+	stat->total = 0;
+	stat->max = 0;
+	memset ( stat->histogram, 0, sizeof ( stat->histogram ) );
+}
+
+static void profileStop ( ProfileData *data )
+{
+	if ( !data->active )
+	{
+		return;
+	}
+
+	g_hash_table_foreach_remove ( data->wraps, profileUnwrap, data->interp );
+	data->active = 0;
+	--gnoclProfiling;
+}
+
+static int profileStart ( Tcl_Interp *interp, ProfileData *data, int traceSize )
+{
+	int k;
+
+	profileStop ( data );
+
+	if ( data->wraps == NULL )
+	{
+		data->wraps = g_hash_table_new_full ( g_str_hash, g_str_equal, NULL, profileWrapFree );
+	}
+
+	for ( k = 0; k < GNOCL_PROFILE_KINDS; k++ )
+	{
+		if ( data->stats[k] != NULL )
+		{
+			g_hash_table_foreach ( data->stats[k], profileClearStat, NULL );
+		}
+	}
+
+	if ( data->traceSize != traceSize )
+	{
+		g_free ( data->trace );
+		data->trace = g_new ( ProfileEvent, traceSize );
+		data->traceSize = traceSize;
+	}
+
+	data->traceCount = 0;
+	data->origin = gnoclMonotonicTime ();
+	data->interp = interp;
+	data->active = 1;
+	++gnoclProfiling;
+
+	gnoclForeachWidget ( profileWrapWidget, data );
+
+	return TCL_OK;
+}
+
+static void profileStatToDict ( gpointer key, gpointer value, gpointer user_data )
+{
+	GnoclProfileStat *stat = value;
+	Tcl_Obj *dict = user_data;
+	Tcl_Obj *entry;
+	Tcl_Obj *hist;
+	int k;
+
+	if ( stat->count == 0 )
+	{
+		return;
+	}
+
+	hist = Tcl_NewListObj ( 0, NULL );
+
+	for ( k = 0; k < PROFILE_BUCKETS; k++ )
+	{
+		Tcl_ListObjAppendElement ( NULL, hist, Tcl_NewIntObj ( stat->histogram[k] ) );
+	}
+
+	entry = Tcl_NewListObj ( 0, NULL );
+	Tcl_ListObjAppendElement ( NULL, entry, Tcl_NewStringObj ( "count", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, entry, Tcl_NewIntObj ( stat->count ) );
+	Tcl_ListObjAppendElement ( NULL, entry, Tcl_NewStringObj ( "total", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, entry, Tcl_NewWideIntObj ( stat->total ) );
+	Tcl_ListObjAppendElement ( NULL, entry, Tcl_NewStringObj ( "max", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, entry, Tcl_NewWideIntObj ( stat->max ) );
+	Tcl_ListObjAppendElement ( NULL, entry, Tcl_NewStringObj ( "histogram", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, entry, hist );
+
+	Tcl_ListObjAppendElement ( NULL, dict, Tcl_NewStringObj ( stat->key, -1 ) );
+	Tcl_ListObjAppendElement ( NULL, dict, entry );
+}
+
+/**
+\brief      Report as a dict {scripts {key {count n total us max us histogram {..}}} callbacks .. widgets .. events n}
+\date       2026-10
+**/
+static Tcl_Obj *profileDict ( ProfileData *data )
+{
+	Tcl_Obj *res = Tcl_NewListObj ( 0, NULL );
+	int k;
+
+	for ( k = 0; k < GNOCL_PROFILE_KINDS; k++ )
+	{
+		Tcl_Obj *dict = Tcl_NewListObj ( 0, NULL );
+
+		if ( data->stats[k] != NULL )
+		{
+			g_hash_table_foreach ( data->stats[k], profileStatToDict, dict );
+		}
+
+		Tcl_ListObjAppendElement ( NULL, res, Tcl_NewStringObj ( profileKinds[k], -1 ) );
+		Tcl_ListObjAppendElement ( NULL, res, dict );
+	}
+
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewStringObj ( "events", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewIntObj ( data->traceCount ) );
+
+	return res;
+}
+
+static void appendJsonString ( GString *json, const char *str )
+{
+	g_string_append_c ( json, '"' );
+
+	for ( ; *str != '\0'; str++ )
+	{
+		switch ( *str )
+		{
+			case '"':
+				g_string_append ( json, "\\\"" );
+				break;
+			case '\\':
+				g_string_append ( json, "\\\\" );
+				break;
+			default:
+
+				if ( ( unsigned char ) *str < 0x20 )
+				{
+					g_string_append_printf ( json, "\\u%04x", *str );
+				}
+
+				else
+				{
+					g_string_append_c ( json, *str );
+				}
+		}
+	}
+
+	g_string_append_c ( json, '"' );
+}
+
+/**
+\brief      The trace ring as Chrome trace event JSON, complete events in microseconds.
+\date       2026-10
+**/
+static gchar *profileChromeTrace ( ProfileData *data )
+{
+	GString *json = g_string_new ( "{\"traceEvents\":[" );
+	guint n = MIN ( data->traceCount, data->traceSize );
+	guint i;
+
+	for ( i = data->traceCount - n; i != data->traceCount; i++ )
+	{
+		ProfileEvent *ev = data->trace + i % data->traceSize;
+
+		g_string_append ( json, i + n == data->traceCount ? "\n{\"name\":" : ",\n{\"name\":" );
+		appendJsonString ( json, ev->stat->key );
+		g_string_append_printf ( json, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%" G_GINT64_FORMAT
+								 ",\"dur\":%" G_GINT64_FORMAT ",\"pid\":1,\"tid\":1}",
+								 profileKinds[ev->stat->kind], ev->start - data->origin, ev->duration );
+	}
+
+	g_string_append ( json, "\n],\"displayTimeUnit\":\"ms\"}\n" );
+
+	return g_string_free ( json, FALSE );
+}
+
+/**
+\brief      gnocl::debug profile start ?-traceSize n? | stop | report ?-format dict|chrome? ?-file name?
+\date       2026-10
+\note       Times percent substituted callback scripts, gnocl::callback scripts
+            and widget command dispatch. Data is kept per thread.
+**/
+static int profileCmd ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	static const char *cmds[] = { "start", "stop", "report", NULL };
+	enum cmdIdx { StartIdx, StopIdx, ReportIdx };
+	ProfileData *data = profileData ();
+	int idx;
+
+	if ( objc < 3 )
+	{
+		Tcl_WrongNumArgs ( interp, 2, objv, "start|stop|report ?option value ...?" );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_GetIndexFromObj ( interp, objv[2], cmds, "command", TCL_EXACT, &idx ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	switch ( idx )
+	{
+		case StartIdx:
+			{
+				GnoclOption options[] =
+				{
+					{ "-traceSize", GNOCL_INT, NULL },
+					{ NULL }
+				};
+				int traceSize = PROFILE_TRACE_SIZE;
+
+				if ( gnoclParseOptions ( interp, objc - 2, objv + 2, options ) != TCL_OK )
+				{
+					gnoclClearOptions ( options );
+					return TCL_ERROR;
+				}
+
+				if ( options[0].status == GNOCL_STATUS_CHANGED )
+				{
+					traceSize = options[0].val.i;
+				}
+
+				gnoclClearOptions ( options );
+
+				if ( traceSize < 1 )
+				{
+					Tcl_SetResult ( interp, "GNOCL ERROR: -traceSize must be greater zero.", TCL_STATIC );
+					return TCL_ERROR;
+				}
+
+				return profileStart ( interp, data, traceSize );
+			}
+		case StopIdx:
+			{
+				profileStop ( data );
+			}
+			break;
+		case ReportIdx:
+			{
+				GnoclOption options[] =
+				{
+					{ "-format", GNOCL_OBJ, NULL },
+					{ "-file", GNOCL_STRING, NULL },
+					{ NULL }
+				};
+				static const char *formats[] = { "dict", "chrome", NULL };
+				enum formatIdx { DictIdx, ChromeIdx };
+				int format = DictIdx;
+				int ret = TCL_OK;
+
+				if ( data->trace == NULL )
+				{
+					Tcl_SetResult ( interp, "GNOCL ERROR: No profile has been started.", TCL_STATIC );
+					return TCL_ERROR;
+				}
+
+				if ( gnoclParseOptions ( interp, objc - 2, objv + 2, options ) != TCL_OK )
+				{
+					gnoclClearOptions ( options );
+					return TCL_ERROR;
+				}
+
+				if ( options[0].status == GNOCL_STATUS_CHANGED
+						&& Tcl_GetIndexFromObj ( interp, options[0].val.obj, formats, "format", TCL_EXACT, &format ) != TCL_OK )
+				{
+					gnoclClearOptions ( options );
+					return TCL_ERROR;
+				}
+
+				if ( format == DictIdx )
+				{
+					Tcl_SetObjResult ( interp, profileDict ( data ) );
+				}
+
+				else
+				{
+					gchar *json = profileChromeTrace ( data );
+
+					if ( options[1].status == GNOCL_STATUS_CHANGED )
+					{
+						GError *err = NULL;
+
+						if ( !g_file_set_contents ( options[1].val.str, json, -1, &err ) )
+						{
+							Tcl_AppendResult ( interp, "GNOCL ERROR: ", err->message, ( char * ) NULL );
+							g_error_free ( err );
+							ret = TCL_ERROR;
+						}
+					}
+
+					else
+					{
+						Tcl_SetObjResult ( interp, Tcl_NewStringObj ( json, -1 ) );
+					}
+
+					g_free ( json );
+				}
+
+				gnoclClearOptions ( options );
+
+				return ret;
+			}
+	}
+
+	return TCL_OK;
+}
+
+/* charge the time since the last mark to the innermost open category */
+static void frameMark ( FrameData *frame, gint64 now )
+{
+	int kind = GNOCL_FRAME_OTHER;
+
+	if ( frame->depth > 0 )
+	{
+		kind = frame->stack[MIN ( frame->depth, FRAME_STACK ) - 1];
+	}
+
+	frame->current.spent[kind] += now - frame->mark;
+	frame->mark = now;
+}
+
+static void frameBegin ( FrameData *frame, gint64 now )
+{
+	memset ( &frame->current, 0, sizeof ( frame->current ) );
+	frame->current.time = now;
+	frame->mark = now;
+	frame->open = 1;
+}
+
+static void frameEnd ( FrameData *frame, gint64 now )
+{
+	gint64 busy;
+	int k;
+
+	if ( !frame->open )
+	{
+		return;
+	}
+
+	frameMark ( frame, now );
+	busy = now - frame->current.time;
+
+	frame->iterations++;
+	frame->busy += busy;
+
+	if ( busy > frame->max )
+	{
+		frame->max = busy;
+	}
+
+	for ( k = 0; k < GNOCL_FRAME_KINDS; k++ )
+	{
+		frame->spent[k] += frame->current.spent[k];
+	}
+
+	if ( busy >= frame->threshold )
+	{
+		FrameSample *sample = frame->ring + frame->stalls++ % frame->size;
+
+		*sample = frame->current;
+		sample->time -= frame->origin;
+		sample->busy = busy;
+	}
+
+	frame->open = 0;
+}
+
+/**
+\brief      Account the following time to kind until gnoclFramePop.
+\date       2026-10
+**/
+void gnoclFramePush ( enum GnoclFrameKind kind )
+{
+	FrameData *frame = &profileData ()->frame;
+
+	if ( !frame->active )
+	{
+		return;
+	}
+
+	frameMark ( frame, gnoclMonotonicTime () );
+
+	if ( frame->depth < FRAME_STACK )
+	{
+		frame->stack[frame->depth] = kind;
+	}
+
+	frame->depth++;
+}
+
+void gnoclFramePop ( void )
+{
+	FrameData *frame = &profileData ()->frame;
+
+	if ( !frame->active || frame->depth == 0 )
+	{
+		return;
+	}
+
+	frameMark ( frame, gnoclMonotonicTime () );
+	frame->depth--;
+}
+
+/**
+\brief      Poll function of the default main context while frameStats runs.
+\date       2026-10
+\note       The time between two polls is time in which nothing on screen can
+            react, so that is what an iteration measures, nested loops included.
+**/
+static gint framePoll ( GPollFD *fds, guint nfds, gint timeout )
+{
+	FrameData *frame = &profileData ()->frame;
+	gint ret;
+
+	frameEnd ( frame, gnoclMonotonicTime () );
+	ret = frame->poll ( fds, nfds, timeout );
+
+	if ( frame->active )
+	{
+		frameBegin ( frame, gnoclMonotonicTime () );
+	}
+
+	return ret;
+}
+
+/* replaces gtk_main_do_event while frameStats runs */
+static void frameEventHandler ( GdkEvent *event, gpointer data )
+{
+	gnoclFramePush ( event->type == GDK_EXPOSE ? GNOCL_FRAME_PAINT : GNOCL_FRAME_EVENTS );
+	gtk_main_do_event ( event );
+	gnoclFramePop ();
+}
+
+static void frameStop ( FrameData *frame )
+{
+	if ( !frame->active )
+	{
+		return;
+	}
+
+	frame->active = 0;
+	frame->open = 0;
+	g_main_context_set_poll_func ( NULL, frame->poll );
+	gdk_event_handler_set ( ( GdkEventFunc ) gtk_main_do_event, NULL, NULL );
+	--gnoclFrameStats;
+	--gnoclProfiling;
+}
+
+static void frameStart ( FrameData *frame, int threshold, int size )
+{
+	frameStop ( frame );
+
+	if ( frame->size != size )
+	{
+		g_free ( frame->ring );
+		frame->ring = g_new ( FrameSample, size );
+		frame->size = size;
+	}
+
+	frame->threshold = ( gint64 ) threshold * 1000;
+	frame->origin = gnoclMonotonicTime ();
+	frame->depth = 0;
+	frame->iterations = 0;
+	frame->busy = 0;
+	frame->max = 0;
+	frame->stalls = 0;
+	memset ( frame->spent, 0, sizeof ( frame->spent ) );
+
+	frame->poll = g_main_context_get_poll_func ( NULL );
+	g_main_context_set_poll_func ( NULL, framePoll );
+	gdk_event_handler_set ( frameEventHandler, NULL, NULL );
+
+	frame->active = 1;
+	++gnoclFrameStats;
+	++gnoclProfiling;
+}
+
+static void appendPair ( Tcl_Obj *dict, const char *key, Tcl_Obj *val )
+{
+	Tcl_ListObjAppendElement ( NULL, dict, Tcl_NewStringObj ( key, -1 ) );
+	Tcl_ListObjAppendElement ( NULL, dict, val );
+}
+
+/**
+\brief      {iterations n busy us max us events us paint us tcl us idle us other us
+             threshold ms stalls n samples {{time us busy us events us ... script s} ...}}
+\date       2026-10
+**/
+static Tcl_Obj *frameDict ( FrameData *frame )
+{
+	Tcl_Obj *res = Tcl_NewListObj ( 0, NULL );
+	Tcl_Obj *samples = Tcl_NewListObj ( 0, NULL );
+	guint n = MIN ( frame->stalls, frame->size );
+	guint i;
+	int k;
+
+	appendPair ( res, "iterations", Tcl_NewIntObj ( frame->iterations ) );
+	appendPair ( res, "busy", Tcl_NewWideIntObj ( frame->busy ) );
+	appendPair ( res, "max", Tcl_NewWideIntObj ( frame->max ) );
+
+	for ( k = 0; k < GNOCL_FRAME_KINDS; k++ )
+	{
+		appendPair ( res, frameKinds[k], Tcl_NewWideIntObj ( frame->spent[k] ) );
+	}
+
+	appendPair ( res, "threshold", Tcl_NewWideIntObj ( frame->threshold / 1000 ) );
+	appendPair ( res, "stalls", Tcl_NewIntObj ( frame->stalls ) );
+
+	/* oldest first */
+	for ( i = frame->stalls - n; i != frame->stalls; i++ )
+	{
+		FrameSample *sample = frame->ring + i % frame->size;
+		Tcl_Obj *dict = Tcl_NewListObj ( 0, NULL );
+
+		appendPair ( dict, "time", Tcl_NewWideIntObj ( sample->time ) );
+		appendPair ( dict, "busy", Tcl_NewWideIntObj ( sample->busy ) );
+
+		for ( k = 0; k < GNOCL_FRAME_KINDS; k++ )
+		{
+			appendPair ( dict, frameKinds[k], Tcl_NewWideIntObj ( sample->spent[k] ) );
+		}
+
+		appendPair ( dict, "script", Tcl_NewStringObj ( sample->script != NULL ? sample->script : "", -1 ) );
+		appendPair ( dict, "scriptTime", Tcl_NewWideIntObj ( sample->scriptTime ) );
+
+		Tcl_ListObjAppendElement ( NULL, samples, dict );
+	}
+
+	appendPair ( res, "samples", samples );
+
+	return res;
+}
+
+/**
+\brief      gnocl::debug frameStats start ?-threshold ms? ?-size n? | stop | get
+\date       2026-10
+\note       Splits main loop time into GTK event dispatch, painting, Tcl event
+            servicing, gnocl::callback scripts and the rest. Iterations of at
+            least -threshold ms are kept in a ring of -size samples together
+            with the slowest script that ran in them.
+**/
+static int frameStatsCmd ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	static const char *cmds[] = { "start", "stop", "get", NULL };
+	enum cmdIdx { StartIdx, StopIdx, GetIdx };
+	FrameData *frame = &profileData ()->frame;
+	int idx;
+
+	if ( objc < 3 )
+	{
+		Tcl_WrongNumArgs ( interp, 2, objv, "start|stop|get ?option value ...?" );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_GetIndexFromObj ( interp, objv[2], cmds, "command", TCL_EXACT, &idx ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	switch ( idx )
+	{
+		case StartIdx:
+			{
+				GnoclOption options[] =
+				{
+					{ "-threshold", GNOCL_INT, NULL },
+					{ "-size", GNOCL_INT, NULL },
+					{ NULL }
+				};
+				int threshold = FRAME_THRESHOLD;
+				int size = FRAME_SIZE;
+
+				if ( gnoclParseOptions ( interp, objc - 2, objv + 2, options ) != TCL_OK )
+				{
+					gnoclClearOptions ( options );
+					return TCL_ERROR;
+				}
+
+				if ( options[0].status == GNOCL_STATUS_CHANGED )
+				{
+					threshold = options[0].val.i;
+				}
+
+				if ( options[1].status == GNOCL_STATUS_CHANGED )
+				{
+					size = options[1].val.i;
+				}
+
+				gnoclClearOptions ( options );
+
+				if ( threshold < 0 || size < 1 )
+				{
+					Tcl_SetResult ( interp, "GNOCL ERROR: -threshold must not be negative and -size must be greater zero.", TCL_STATIC );
+					return TCL_ERROR;
+				}
+
+				frameStart ( frame, threshold, size );
+			}
+			break;
+		case StopIdx:
+			{
+				frameStop ( frame );
+			}
+			break;
+		case GetIdx:
+			{
+				if ( frame->ring == NULL )
+				{
+					Tcl_SetResult ( interp, "GNOCL ERROR: frameStats has not been started.", TCL_STATIC );
+					return TCL_ERROR;
+				}
+
+				Tcl_SetObjResult ( interp, frameDict ( frame ) );
+			}
+			break;
+	}
+
+	return TCL_OK;
+}
+
 /**
 \brief
 \author     PGB
+\note       2026-10 added profile and frameStats
 **/
 int gnoclDebugCmd ( ClientData data, Tcl_Interp *interp,
 					int objc, Tcl_Obj * const objv[] )
 {
-	static const char *cmd[] = { "breakpoint", NULL };
-	enum optIdx { BreakpointIdx };
+	static const char *cmd[] = { "breakpoint", "profile", "frameStats", NULL };
+	enum optIdx { BreakpointIdx, ProfileIdx, FrameStatsIdx };
 	int idx;
 
-	if ( objc != 2 )
+	if ( objc < 2 )
 	{
 		Tcl_WrongNumArgs ( interp, 1, objv, "option" );
 		return TCL_ERROR;
@@ -46,9 +967,20 @@ int gnoclDebugCmd ( ClientData data, Tcl_Interp *interp,
 	switch ( idx )
 	{
 		case BreakpointIdx:
+
+			if ( objc != 2 )
+			{
+				Tcl_WrongNumArgs ( interp, 2, objv, NULL );
+				return TCL_ERROR;
+			}
+
 			/* this is only for debugging */
 			G_BREAKPOINT();
 			break;
+		case ProfileIdx:
+			return profileCmd ( interp, objc, objv );
+		case FrameStatsIdx:
+			return frameStatsCmd ( interp, objc, objv );
 	}
 
 	return TCL_OK;
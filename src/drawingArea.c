@@ -13,6 +13,19 @@
     Implementation of gnocl::drawingArea
 \subsection subsection1 Implemented gnocl::drawingArea Options
 \subsection subsection2 Implemented gnocl::drawingArea Commands
+    draw type coords ?-color c -fill c -width w -text str -font f -pixbuf name?
+        Adds an item to the display list and returns its id.
+    item delete|move|coords|configure|bbox id ?args?
+    plot name -points {x y ...} | -packed float32Bytes ?-style line|points -color c -width w?
+        Adds or replaces a series, decimated to the first, min, max and last
+        sample of each pixel column.
+    erase
+        Removes all items.
+    invalidate ?{x y width height}?
+        Marks an area, by default all, for repainting.
+    cacheStats
+        With -cacheSurface 1, the number and time in ms of repaints and the
+        number of exposes copied from the cache.
 
 \subsection subsection3 Sample Tcl Script
 \code
@@ -28,7 +41,9 @@
 
 #include "gnocl.h"
 #include <gdk/gdkkeysyms.h>
+#include <pango/pangocairo.h>
 #include <string.h>
+#include <math.h>
 #include <assert.h>
 
 /*
@@ -38,7 +53,9 @@
     customised widget creation.
 */
 
-static gint _n = 4; /* counter,number of implements widget options */
+static gint _n = 6; /* counter,number of implements widget options */
+
+static const int cacheSurfaceIdx = 5;
 
 static GnoclOption drawingAreaOptions[] =
 {
@@ -48,6 +65,7 @@ static GnoclOption drawingAreaOptions[] =
 	{ "-name", GNOCL_STRING, "name" },
 	{ "-onShowHelp", GNOCL_OBJ, "", gnoclOptOnShowHelp },
 	{ "-cursor", GNOCL_OBJ, "", gnoclOptCursor },
+	{ "-cacheSurface", GNOCL_BOOL, NULL },
 	/* widget specific options, 15 blank spaces */
 	{ "", GNOCL_OBJ, "", NULL },
 	{ "", GNOCL_OBJ, "", NULL },
@@ -68,6 +86,8 @@ static GnoclOption drawingAreaOptions[] =
 	{ NULL },
 };
 
+static void setSurfaceCache ( GtkWidget *area, int on );
+
 /**
 \brief
 \author     William J Giddings
@@ -79,6 +99,11 @@ static int configure ( Tcl_Interp *interp, GtkDrawingArea *area, GnoclOption opt
 
 	gint ret = gnoclSetOptions ( interp, options, area, -1 );
 
+	if ( options[cacheSurfaceIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		setSurfaceCache ( GTK_WIDGET ( area ), options[cacheSurfaceIdx].val.b );
+	}
+
 	return TCL_OK;
 }
 
@@ -107,87 +132,1571 @@ enum OptsIdx
 };
 
 
+/*
+    Offscreen surface cache, -cacheSurface 1.
+    The painted result of an expose is copied into a pixmap the size of the
+    allocation. Later exposes which do not touch a dirty area, e.g. after
+    window overlap, are served from the pixmap and the -onExpose script and
+    the display list are not run. Areas become dirty through "invalidate",
+    display list changes and resizing.
+*/
+
+typedef struct
+{
+	GdkPixmap      *pixmap;
+	GdkGC          *gc;
+	gint           width;
+	gint           height;
+	GdkRegion      *dirty;
+	GdkEventExpose *event;      /* expose the decision below belongs to */
+	int            hit;
+	GTimer         *timer;
+	guint          repaints;
+	guint          blits;
+	gdouble        repaintTime;
+} SurfaceCache;
+
 /**
-/brief
-/author William J Giddings
-/date   2008-08
 **/
-int drawingAreaFunc ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+static void cacheFree ( gpointer data )
 {
-#ifdef DEBUG_DRAWING_AREA
-	g_printf ( "drawingAreaFunc\n" );
-	gint _i;
+	SurfaceCache *cache = ( SurfaceCache * ) data;
 
-	for ( _i = 0; _i < objc; _i++ )
+	if ( cache->pixmap != NULL )
 	{
-		g_printf ( "\targ %d = %s\n", _i,  Tcl_GetString ( objv[_i] ) );
+		g_object_unref ( cache->pixmap );
+		g_object_unref ( cache->gc );
 	}
 
-#endif
+	gdk_region_destroy ( cache->dirty );
+	g_timer_destroy ( cache->timer );
+	g_free ( cache );
+}
 
-	static const char *cmds[] =
+/**
+\brief      Forget the verdict of the previous expose before any handler runs.
+\note       Expose events are often built at the same stack address, and a
+            handler that stops the emission early never reaches the point
+            where the verdict is cleared, so the event pointer alone does
+            not identify an expose.
+**/
+static gboolean cacheEmissionHook ( GSignalInvocationHint *hint, guint n, const GValue *params, gpointer data )
+{
+	GObject *obj = g_value_get_object ( params );
+	SurfaceCache *cache = g_object_get_data ( obj, "gnocl::surfaceCache" );
+
+	if ( cache != NULL )
 	{
-		"draw", "cget", "configure", "delete", "class", "erase", "option", NULL
-	};
-	enum cmdIdx
+		cache->event = NULL;
+	}
+
+	return TRUE;
+}
+
+/**
+\brief      Decide once per expose whether it can be served from the cache.
+\note       A changed allocation recreates the pixmap and dirties all of it.
+**/
+static int cacheCheck ( GtkWidget *widget, SurfaceCache *cache, GdkEventExpose *event )
+{
+	GdkRegion *region;
+
+	if ( cache->event == event )
 	{
-		DrawIdx, CgetIdx, ConfigureIdx, DeleteIdx, ClassIdx, EraseIdx, OptionIdx
-	};
+		return cache->hit;
+	}
 
+	cache->event = event;
 
-	/* relocate these to relevant parts of the souce file */
-	static const char *drawOpts[] =
+	if ( cache->pixmap == NULL || cache->width != widget->allocation.width || cache->height != widget->allocation.height )
 	{
-		"point", "points", "line", "lines", "pixbuf", "segments",
-		"rectangle", "arc", "polygon", "trapezoids", "glyph",
-		"glyphTransformed", "layoutLine", "layoutWithColors",
-		"string", "text", "image",
-		NULL
-	};
+		GdkRectangle all = { 0, 0, widget->allocation.width, widget->allocation.height };
+
+		if ( cache->pixmap != NULL )
+		{
+			g_object_unref ( cache->pixmap );
+			g_object_unref ( cache->gc );
+		}
+
+		cache->width = all.width;
+		cache->height = all.height;
+		cache->pixmap = gdk_pixmap_new ( widget->window, MAX ( all.width, 1 ), MAX ( all.height, 1 ), -1 );
+		cache->gc = gdk_gc_new ( cache->pixmap );
+		gdk_region_destroy ( cache->dirty );
+		cache->dirty = gdk_region_rectangle ( &all );
+	}
 
-	enum drawOptsIdx
+	region = gdk_region_copy ( event->region );
+	gdk_region_intersect ( region, cache->dirty );
+	cache->hit = gdk_region_empty ( region );
+	gdk_region_destroy ( region );
+
+	if ( !cache->hit )
 	{
-		PointIdx, PointsIdx, LineIdx, LinesIdx, PixbufIdx, SegmentsIdx,
-		RectangleIdx, ArcIdx, PolygonIdx, TrapezoidsIdx, GlypIdx,
-		GlyphTransformedIdx, LayoutLineIdx, LayoutWithColorsIdx,
-		StringIdx, TextIdx, ImageIdx
-	};
+		g_timer_start ( cache->timer );
+	}
 
+	return cache->hit;
+}
 
+/**
+\brief      Copy the cached pixels into the exposed region and stop the emission.
+**/
+static gboolean cacheExpose ( GtkWidget *widget, GdkEventExpose *event, gpointer data )
+{
+	SurfaceCache *cache = ( SurfaceCache * ) data;
 
-	/*
-	static const char *events[] =
+	if ( cacheCheck ( widget, cache, event ) )
 	{
-	    "expose",           "motion",           "motionHint",
-	    "buttonMotion",     "button1Motion",    "button2Motion",
-	    "button3Motion",    "buttonPress",      "buttonRelease",
-	    "keyPress",         "keyRelease",       "enter",
-	    "leave",            "focus",            "structure",
-	    "propertyChange",   "visibility",       "proximityIn",
-	    "proximityOut",     "substructure",     "scroll",
-	    "all", NULL
-	};
-	*/
+		cairo_t *cr = gdk_cairo_create ( widget->window );
 
-	GtkWidget *area = GTK_WIDGET ( data );
+		gdk_cairo_region ( cr, event->region );
+		cairo_clip ( cr );
+		gdk_cairo_set_source_pixmap ( cr, cache->pixmap, 0, 0 );
+		cairo_paint ( cr );
+		cairo_destroy ( cr );
 
-	int idx;
-	int idx2;
+		++cache->blits;
+		cache->event = NULL;
 
-	if ( objc < 2 )
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/**
+\brief      After a real repaint, keep what was drawn.
+\note       During an expose reading from the window returns the content of
+            the paint buffer, i.e. the result of all handlers.
+**/
+static gboolean cacheExposeAfter ( GtkWidget *widget, GdkEventExpose *event, gpointer data )
+{
+	SurfaceCache *cache = ( SurfaceCache * ) data;
+	GdkRectangle *rects;
+	gint         k, no;
+
+	if ( cache->event != event || cache->hit )
 	{
-		Tcl_WrongNumArgs ( interp, 1, objv, "command" );
-		return TCL_ERROR;
+		return FALSE;
 	}
 
-	if ( Tcl_GetIndexFromObj ( interp, objv[1], cmds, "command", TCL_EXACT, &idx ) != TCL_OK )
+	gdk_region_get_rectangles ( event->region, &rects, &no );
+
+	for ( k = 0; k < no; ++k )
 	{
-		return TCL_ERROR;
+		gdk_draw_drawable ( cache->pixmap, cache->gc, widget->window,
+							rects[k].x, rects[k].y, rects[k].x, rects[k].y, rects[k].width, rects[k].height );
 	}
 
-	switch ( idx )
+	g_free ( rects );
+
+	gdk_region_subtract ( cache->dirty, event->region );
+	++cache->repaints;
+	cache->repaintTime += g_timer_elapsed ( cache->timer, NULL );
+	cache->event = NULL;
+
+	return FALSE;
+}
+
+/**
+\brief      Return 1 if the expose of widget is served from its surface cache.
+\note       Expose handlers connected before the cache call this to skip
+            their work, see doOnExpose.
+**/
+int gnoclExposeFromCache ( GtkWidget *widget, GdkEventExpose *event )
+{
+	SurfaceCache *cache = g_object_get_data ( G_OBJECT ( widget ), "gnocl::surfaceCache" );
+
+	return cache != NULL && cacheCheck ( widget, cache, event );
+}
+
+/**
+**/
+static void setSurfaceCache ( GtkWidget *area, int on )
+{
+	static gulong hook = 0;
+	SurfaceCache *cache = g_object_get_data ( G_OBJECT ( area ), "gnocl::surfaceCache" );
+
+	if ( on && cache == NULL )
+	{
+		if ( hook == 0 )
+		{
+			hook = g_signal_add_emission_hook ( g_signal_lookup ( "expose-event", GTK_TYPE_WIDGET ),
+												0, cacheEmissionHook, NULL, NULL );
+		}
+
+		cache = g_new0 ( SurfaceCache, 1 );
+		cache->dirty = gdk_region_new ();
+		cache->timer = g_timer_new ();
+
+		g_object_set_data_full ( G_OBJECT ( area ), "gnocl::surfaceCache", cache, cacheFree );
+		g_signal_connect ( G_OBJECT ( area ), "expose-event", G_CALLBACK ( cacheExpose ), cache );
+		g_signal_connect_after ( G_OBJECT ( area ), "expose-event", G_CALLBACK ( cacheExposeAfter ), cache );
+	}
+
+	else if ( !on && cache != NULL )
+	{
+		g_signal_handlers_disconnect_matched ( G_OBJECT ( area ), G_SIGNAL_MATCH_DATA, 0, 0, NULL, NULL, cache );
+		g_object_set_data ( G_OBJECT ( area ), "gnocl::surfaceCache", NULL );
+	}
+}
+
+/**
+\brief      Mark rect, or the whole widget if rect is NULL, for repainting.
+**/
+static void areaInvalidate ( GtkWidget *area, GdkRectangle *rect )
+{
+	SurfaceCache *cache = g_object_get_data ( G_OBJECT ( area ), "gnocl::surfaceCache" );
+	GdkRectangle all = { 0, 0, area->allocation.width, area->allocation.height };
+
+	if ( rect == NULL )
+	{
+		rect = &all;
+	}
+
+	if ( cache != NULL )
+	{
+		gdk_region_union_with_rect ( cache->dirty, rect );
+	}
+
+	if ( GTK_WIDGET_REALIZED ( area ) )
+	{
+		gdk_window_invalidate_rect ( area->window, rect, FALSE );
+	}
+}
+
+/*
+    Retained display list.
+    Items added with "draw" are kept in a per widget scene and repainted from
+    C on every expose. A uniform grid of cells indexes the item bounding
+    boxes, so an expose only visits the items touching its damaged region.
+*/
+
+static const char *drawOpts[] =
+{
+	"point", "points", "line", "lines", "pixbuf", "segments",
+	"rectangle", "arc", "polygon", "trapezoids", "glyph",
+	"glyphTransformed", "layoutLine", "layoutWithColors",
+	"string", "text", "image",
+	NULL
+};
+
+enum drawOptsIdx
+{
+	PointIdx, PointsIdx, LineIdx, LinesIdx, PixbufIdx, SegmentsIdx,
+	RectangleIdx, ArcIdx, PolygonIdx, TrapezoidsIdx, GlypIdx,
+	GlyphTransformedIdx, LayoutLineIdx, LayoutWithColorsIdx,
+	StringIdx, TextIdx, ImageIdx
+};
+
+#define SCENE_CELL      64      /* edge length of an index cell in pixels */
+#define SCENE_MAX_CELLS 256     /* items covering more cells are kept apart */
+
+typedef struct
+{
+	guint        id;
+	int          type;
+	gdouble      *coords;
+	int          noCoords;
+	gdouble      color[4];
+	gdouble      fill[4];
+	int          filled;
+	gdouble      width;
+	gchar        *text;
+	gchar        *font;
+	GdkPixbuf    *pixbuf;
+	GdkRectangle bbox;
+	int          large;
+	guint        stamp;         /* last query which collected the item */
+} DrawItem;
+
+typedef struct
+{
+	GtkWidget  *area;
+	GHashTable *items;          /* id -> DrawItem */
+	GHashTable *cells;          /* packed cell position -> GPtrArray of items */
+	GHashTable *series;         /* plot series name -> item id */
+	GPtrArray  *large;
+	guint      nextId;
+	guint      stamp;
+} DrawScene;
+
+static const int colorIdx = 0;
+static const int fillIdx = 1;
+static const int widthIdx = 2;
+static const int textIdx = 3;
+static const int fontIdx = 4;
+static const int pixbufIdx = 5;
+
+static GnoclOption itemOptions[] =
+{
+	{ "-color", GNOCL_OBJ, NULL },
+	{ "-fill", GNOCL_OBJ, NULL },
+	{ "-width", GNOCL_DOUBLE, NULL },
+	{ "-text", GNOCL_STRING, NULL },
+	{ "-font", GNOCL_STRING, NULL },
+	{ "-pixbuf", GNOCL_STRING, NULL },
+	{ NULL }
+};
+
+/**
+**/
+static gpointer cellKey ( int cx, int cy )
+{
+	return GUINT_TO_POINTER ( ( ( guint ) cx & 0xFFFF ) << 16 | ( ( guint ) cy & 0xFFFF ) );
+}
+
+/**
+**/
+static int cellFloor ( int v )
+{
+	return v >= 0 ? v / SCENE_CELL : - ( ( -v - 1 ) / SCENE_CELL ) - 1;
+}
+
+/**
+\brief      Add the item to, or remove it from, the cells under its bounding box.
+**/
+static void sceneIndex ( DrawScene *scene, DrawItem *item, int add )
+{
+	int x0 = cellFloor ( item->bbox.x );
+	int y0 = cellFloor ( item->bbox.y );
+	int x1 = cellFloor ( item->bbox.x + item->bbox.width - 1 );
+	int y1 = cellFloor ( item->bbox.y + item->bbox.height - 1 );
+	int cx, cy;
+
+	if ( add )
+	{
+		item->large = ( x1 - x0 + 1 ) * ( y1 - y0 + 1 ) > SCENE_MAX_CELLS;
+	}
+
+	if ( item->large )
+	{
+		if ( add )
+		{
+			g_ptr_array_add ( scene->large, item );
+		}
+
+		else
+		{
+			g_ptr_array_remove_fast ( scene->large, item );
+		}
+
+		return;
+	}
+
+	for ( cx = x0; cx <= x1; ++cx )
+	{
+		for ( cy = y0; cy <= y1; ++cy )
+		{
+			GPtrArray *cell = g_hash_table_lookup ( scene->cells, cellKey ( cx, cy ) );
+
+			if ( add )
+			{
+				if ( cell == NULL )
+				{
+					cell = g_ptr_array_new ();
+					g_hash_table_insert ( scene->cells, cellKey ( cx, cy ), cell );
+				}
+
+				g_ptr_array_add ( cell, item );
+			}
+
+			else if ( cell != NULL )
+			{
+				g_ptr_array_remove_fast ( cell, item );
+
+				if ( cell->len == 0 )
+				{
+					g_hash_table_remove ( scene->cells, cellKey ( cx, cy ) );
+				}
+			}
+		}
+	}
+}
+
+/**
+\brief      Collect the items intersecting rect which are not yet in hits.
+**/
+static void sceneQuery ( DrawScene *scene, GdkRectangle *rect, GPtrArray *hits )
+{
+	int x0 = cellFloor ( rect->x );
+	int y0 = cellFloor ( rect->y );
+	int x1 = cellFloor ( rect->x + rect->width - 1 );
+	int y1 = cellFloor ( rect->y + rect->height - 1 );
+	int cx, cy;
+	guint k;
+	GdkRectangle isect;
+
+	for ( cx = x0; cx <= x1; ++cx )
+	{
+		for ( cy = y0; cy <= y1; ++cy )
+		{
+			GPtrArray *cell = g_hash_table_lookup ( scene->cells, cellKey ( cx, cy ) );
+
+			if ( cell == NULL )
+			{
+				continue;
+			}
+
+			for ( k = 0; k < cell->len; ++k )
+			{
+				DrawItem *item = g_ptr_array_index ( cell, k );
+
+				if ( item->stamp != scene->stamp && gdk_rectangle_intersect ( rect, &item->bbox, &isect ) )
+				{
+					item->stamp = scene->stamp;
+					g_ptr_array_add ( hits, item );
+				}
+			}
+		}
+	}
+
+	for ( k = 0; k < scene->large->len; ++k )
+	{
+		DrawItem *item = g_ptr_array_index ( scene->large, k );
+
+		if ( item->stamp != scene->stamp && gdk_rectangle_intersect ( rect, &item->bbox, &isect ) )
+		{
+			item->stamp = scene->stamp;
+			g_ptr_array_add ( hits, item );
+		}
+	}
+}
+
+/**
+\brief      Items are painted in the order they were drawn.
+**/
+static gint compareItems ( gconstpointer a, gconstpointer b )
+{
+	const DrawItem *ia = * ( const DrawItem ** ) a;
+	const DrawItem *ib = * ( const DrawItem ** ) b;
+
+	return ia->id < ib->id ? -1 : ia->id > ib->id;
+}
+
+/**
+**/
+static void sceneInvalidate ( DrawScene *scene, GdkRectangle *rect )
+{
+	areaInvalidate ( scene->area, rect );
+}
+
+/**
+\brief      Layout for a text item, measured and drawn with the same setup.
+\note       The context carries the widget's style font and screen resolution,
+            cr, if given, only adds its transformation for drawing.
+**/
+static PangoLayout *itemLayout ( DrawScene *scene, DrawItem *item, cairo_t *cr )
+{
+	PangoContext *context = gtk_widget_create_pango_context ( scene->area );
+	PangoLayout *layout;
+
+	if ( cr != NULL )
+	{
+		pango_cairo_update_context ( cr, context );
+	}
+
+	layout = pango_layout_new ( context );
+	g_object_unref ( context );
+
+	pango_layout_set_text ( layout, item->text ? item->text : "", -1 );
+
+	if ( item->font != NULL )
+	{
+		PangoFontDescription *desc = pango_font_description_from_string ( item->font );
+		pango_layout_set_font_description ( layout, desc );
+		pango_font_description_free ( desc );
+	}
+
+	return layout;
+}
+
+/**
+\brief      Recalculate the bounding box from the coordinates and the line width.
+**/
+static void itemBBox ( DrawScene *scene, DrawItem *item )
+{
+	gdouble x0, y0, x1, y1, pad;
+	int k;
+
+	x0 = x1 = item->coords[0];
+	y0 = y1 = item->coords[1];
+
+	switch ( item->type )
+	{
+		case RectangleIdx:
+		case ArcIdx:
+			{
+				x1 = x0 + item->coords[2];
+				y1 = y0 + item->coords[3];
+			}
+
+			break;
+		case StringIdx:
+		case TextIdx:
+			{
+				PangoLayout *layout = itemLayout ( scene, item, NULL );
+				int w, h;
+
+				pango_layout_get_pixel_size ( layout, &w, &h );
+				g_object_unref ( layout );
+				x1 = x0 + w;
+				y1 = y0 + h;
+			}
+
+			break;
+		case PixbufIdx:
+		case ImageIdx:
+			{
+				x1 = x0 + gdk_pixbuf_get_width ( item->pixbuf );
+				y1 = y0 + gdk_pixbuf_get_height ( item->pixbuf );
+			}
+
+			break;
+		default:
+			{
+				for ( k = 2; k + 1 < item->noCoords; k += 2 )
+				{
+					x0 = MIN ( x0, item->coords[k] );
+					x1 = MAX ( x1, item->coords[k] );
+					y0 = MIN ( y0, item->coords[k+1] );
+					y1 = MAX ( y1, item->coords[k+1] );
+				}
+			}
+	}
+
+	if ( x0 > x1 )
+	{
+		gdouble t = x0; x0 = x1; x1 = t;
+	}
+
+	if ( y0 > y1 )
+	{
+		gdouble t = y0; y0 = y1; y1 = t;
+	}
+
+	pad = item->width / 2 + 1;
+	item->bbox.x = floor ( x0 - pad );
+	item->bbox.y = floor ( y0 - pad );
+	item->bbox.width = ceil ( x1 + pad ) - item->bbox.x;
+	item->bbox.height = ceil ( y1 + pad ) - item->bbox.y;
+}
+
+/**
+**/
+static void itemRender ( DrawScene *scene, cairo_t *cr, DrawItem *item )
+{
+	gdouble *c = item->coords;
+	int k;
+
+	cairo_set_source_rgba ( cr, item->color[0], item->color[1], item->color[2], item->color[3] );
+	cairo_set_line_width ( cr, item->width );
+
+	switch ( item->type )
 	{
+		case PointIdx:
+		case PointsIdx:
+			{
+				for ( k = 0; k + 1 < item->noCoords; k += 2 )
+				{
+					cairo_rectangle ( cr, c[k], c[k+1], 1, 1 );
+				}
+
+				cairo_fill ( cr );
+			}
 
+			return;
+		case SegmentsIdx:
+			{
+				for ( k = 0; k + 3 < item->noCoords; k += 4 )
+				{
+					cairo_move_to ( cr, c[k], c[k+1] );
+					cairo_line_to ( cr, c[k+2], c[k+3] );
+				}
+			}
+
+			break;
+		case LineIdx:
+		case LinesIdx:
+		case PolygonIdx:
+			{
+				cairo_move_to ( cr, c[0], c[1] );
+
+				for ( k = 2; k + 1 < item->noCoords; k += 2 )
+				{
+					cairo_line_to ( cr, c[k], c[k+1] );
+				}
+
+				if ( item->type == PolygonIdx )
+				{
+					cairo_close_path ( cr );
+				}
+			}
+
+			break;
+		case RectangleIdx:
+			{
+				cairo_rectangle ( cr, c[0], c[1], c[2], c[3] );
+			}
+
+			break;
+		case ArcIdx:
+			{
+				/*  x y width height angle1 angle2, angles in degrees as with gdk_draw_arc */
+				cairo_save ( cr );
+				cairo_translate ( cr, c[0] + c[2] / 2, c[1] + c[3] / 2 );
+				cairo_scale ( cr, c[2] / 2 ? c[2] / 2 : 1, c[3] / 2 ? c[3] / 2 : 1 );
+
+				if ( item->filled )
+				{
+					cairo_move_to ( cr, 0, 0 );
+				}
+
+				cairo_arc_negative ( cr, 0, 0, 1, -c[4] * G_PI / 180, - ( c[4] + c[5] ) * G_PI / 180 );
+
+				if ( item->filled )
+				{
+					cairo_close_path ( cr );
+				}
+
+				cairo_restore ( cr );
+			}
+
+			break;
+		case StringIdx:
+		case TextIdx:
+			{
+				PangoLayout *layout = itemLayout ( scene, item, cr );
+
+				cairo_move_to ( cr, c[0], c[1] );
+				pango_cairo_show_layout ( cr, layout );
+				g_object_unref ( layout );
+			}
+
+			return;
+		case PixbufIdx:
+		case ImageIdx:
+			{
+				gdk_cairo_set_source_pixbuf ( cr, item->pixbuf, c[0], c[1] );
+				cairo_paint ( cr );
+			}
+
+			return;
+	}
+
+	if ( item->filled )
+	{
+		cairo_set_source_rgba ( cr, item->fill[0], item->fill[1], item->fill[2], item->fill[3] );
+		cairo_fill_preserve ( cr );
+		cairo_set_source_rgba ( cr, item->color[0], item->color[1], item->color[2], item->color[3] );
+	}
+
+	cairo_stroke ( cr );
+}
+
+/**
+\brief      Paint the items touching the damaged region.
+\note       Returns FALSE, so that -onExpose scripts still run.
+**/
+static gboolean sceneExpose ( GtkWidget *widget, GdkEventExpose *event, gpointer data )
+{
+	DrawScene    *scene = ( DrawScene * ) data;
+	GPtrArray    *hits;
+	GdkRectangle *rects;
+	gint         k, no;
+
+	if ( gnoclExposeFromCache ( widget, event ) )
+	{
+		return FALSE;
+	}
+
+	hits = g_ptr_array_new ();
+	++scene->stamp;
+	gdk_region_get_rectangles ( event->region, &rects, &no );
+
+	for ( k = 0; k < no; ++k )
+	{
+		sceneQuery ( scene, rects + k, hits );
+	}
+
+	g_free ( rects );
+
+	if ( hits->len > 0 )
+	{
+		cairo_t *cr = gdk_cairo_create ( widget->window );
+
+		gdk_cairo_region ( cr, event->region );
+		cairo_clip ( cr );
+		g_ptr_array_sort ( hits, compareItems );
+
+		for ( k = 0; k < hits->len; ++k )
+		{
+			itemRender ( scene, cr, g_ptr_array_index ( hits, k ) );
+		}
+
+		cairo_destroy ( cr );
+	}
+
+	g_ptr_array_free ( hits, 1 );
+
+	return FALSE;
+}
+
+/**
+**/
+static void itemFree ( gpointer data )
+{
+	DrawItem *item = ( DrawItem * ) data;
+
+	if ( item->pixbuf != NULL )
+	{
+		g_object_unref ( item->pixbuf );
+	}
+
+	g_free ( item->coords );
+	g_free ( item->text );
+	g_free ( item->font );
+	g_free ( item );
+}
+
+/**
+**/
+static void sceneFree ( gpointer data )
+{
+	DrawScene *scene = ( DrawScene * ) data;
+
+	g_hash_table_destroy ( scene->cells );
+	g_hash_table_destroy ( scene->items );
+	g_hash_table_destroy ( scene->series );
+	g_ptr_array_free ( scene->large, 1 );
+	g_free ( scene );
+}
+
+/**
+**/
+static void cellFree ( gpointer data )
+{
+	g_ptr_array_free ( ( GPtrArray * ) data, 1 );
+}
+
+/**
+\brief      Return the scene of area, created on first use.
+**/
+static DrawScene *getScene ( GtkWidget *area, int create )
+{
+	DrawScene *scene = g_object_get_data ( G_OBJECT ( area ), "gnocl::scene" );
+
+	if ( scene == NULL && create )
+	{
+		scene = g_new0 ( DrawScene, 1 );
+		scene->area = area;
+		scene->items = g_hash_table_new_full ( g_direct_hash, g_direct_equal, NULL, itemFree );
+		scene->cells = g_hash_table_new_full ( g_direct_hash, g_direct_equal, NULL, cellFree );
+		scene->large = g_ptr_array_new ();
+		scene->series = g_hash_table_new_full ( g_str_hash, g_str_equal, g_free, NULL );
+		scene->nextId = 1;
+
+		g_object_set_data_full ( G_OBJECT ( area ), "gnocl::scene", scene, sceneFree );
+		g_signal_connect ( G_OBJECT ( area ), "expose-event", G_CALLBACK ( sceneExpose ), scene );
+	}
+
+	return scene;
+}
+
+/**
+\brief      Read a colour option into rgba values in the range 0..1.
+**/
+static int getItemColor ( Tcl_Interp *interp, Tcl_Obj *obj, gdouble rgba[4] )
+{
+	int r, g, b, a;
+
+	if ( gnoclGetRGBA ( interp, obj, &r, &g, &b, &a ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	rgba[0] = r / 65535.;
+	rgba[1] = g / 65535.;
+	rgba[2] = b / 65535.;
+	rgba[3] = a / 65535.;
+
+	return TCL_OK;
+}
+
+/**
+\brief      Set the coordinates of an item, checking their number against its type.
+**/
+static int setItemCoords ( Tcl_Interp *interp, DrawItem *item, Tcl_Obj *obj )
+{
+	Tcl_Obj **elems;
+	gdouble *coords;
+	int     k, no, ok;
+
+	if ( Tcl_ListObjGetElements ( interp, obj, &no, &elems ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	switch ( item->type )
+	{
+		case PointIdx:
+		case StringIdx:
+		case TextIdx:
+		case PixbufIdx:
+		case ImageIdx:
+			ok = no == 2;
+			break;
+		case LineIdx:
+		case RectangleIdx:
+			ok = no == 4;
+			break;
+		case ArcIdx:
+			ok = no == 6;
+			break;
+		case SegmentsIdx:
+			ok = no >= 4 && no % 4 == 0;
+			break;
+		case PointsIdx:
+			ok = no >= 2 && no % 2 == 0;
+			break;
+		case LinesIdx:
+			ok = no >= 4 && no % 2 == 0;
+			break;
+		case PolygonIdx:
+			ok = no >= 6 && no % 2 == 0;
+			break;
+		default:
+			ok = 0;
+	}
+
+	if ( !ok )
+	{
+		Tcl_AppendResult ( interp, "wrong number of coordinates for ", drawOpts[item->type], NULL );
+		return TCL_ERROR;
+	}
+
+	coords = g_new ( gdouble, no );
+
+	for ( k = 0; k < no; ++k )
+	{
+		if ( Tcl_GetDoubleFromObj ( interp, elems[k], coords + k ) != TCL_OK )
+		{
+			g_free ( coords );
+			return TCL_ERROR;
+		}
+	}
+
+	g_free ( item->coords );
+	item->coords = coords;
+	item->noCoords = no;
+
+	return TCL_OK;
+}
+
+/**
+\brief      Apply the parsed item options.
+**/
+static int setItemOptions ( Tcl_Interp *interp, DrawItem *item, GnoclOption options[] )
+{
+	if ( options[colorIdx].status == GNOCL_STATUS_CHANGED
+			&& getItemColor ( interp, options[colorIdx].val.obj, item->color ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( options[fillIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		if ( *Tcl_GetString ( options[fillIdx].val.obj ) == '\0' )
+		{
+			item->filled = 0;
+		}
+
+		else
+		{
+			if ( getItemColor ( interp, options[fillIdx].val.obj, item->fill ) != TCL_OK )
+			{
+				return TCL_ERROR;
+			}
+
+			item->filled = 1;
+		}
+	}
+
+	if ( options[widthIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		item->width = options[widthIdx].val.d;
+	}
+
+	if ( options[textIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		g_free ( item->text );
+		item->text = g_strdup ( options[textIdx].val.str );
+	}
+
+	if ( options[fontIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		g_free ( item->font );
+		item->font = g_strdup ( options[fontIdx].val.str );
+	}
+
+	if ( options[pixbufIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		GdkPixbuf *pixbuf = gnoclGetPixBufFromName ( options[pixbufIdx].val.str, interp );
+
+		if ( pixbuf == NULL )
+		{
+			return TCL_ERROR;
+		}
+
+		g_object_ref ( pixbuf );
+
+		if ( item->pixbuf != NULL )
+		{
+			g_object_unref ( item->pixbuf );
+		}
+
+		item->pixbuf = pixbuf;
+	}
+
+	if ( ( item->type == PixbufIdx || item->type == ImageIdx ) && item->pixbuf == NULL )
+	{
+		Tcl_SetResult ( interp, "option -pixbuf required", TCL_STATIC );
+		return TCL_ERROR;
+	}
+
+	return TCL_OK;
+}
+
+/**
+\brief      Add an item to the display list and return its id.
+\note       <widgetId> draw type coords ?-option val ...?
+**/
+static int sceneDraw ( Tcl_Interp *interp, GtkWidget *area, int objc, Tcl_Obj * const objv[] )
+{
+	DrawScene *scene;
+	DrawItem  *item;
+	int       type;
+
+	if ( objc < 4 )
+	{
+		Tcl_WrongNumArgs ( interp, 2, objv, "type coords ?-option val ...?" );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_GetIndexFromObj ( interp, objv[2], drawOpts, "type", TCL_EXACT, &type ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	switch ( type )
+	{
+		case TrapezoidsIdx:
+		case GlypIdx:
+		case GlyphTransformedIdx:
+		case LayoutLineIdx:
+		case LayoutWithColorsIdx:
+			{
+				Tcl_AppendResult ( interp, "draw type \"", drawOpts[type], "\" not yet implemented", NULL );
+				return TCL_ERROR;
+			}
+	}
+
+	item = g_new0 ( DrawItem, 1 );
+	item->type = type;
+	item->color[3] = 1;
+	item->width = 1;
+
+	if ( gnoclParseOptions ( interp, objc - 3, objv + 3, itemOptions ) != TCL_OK
+			|| setItemCoords ( interp, item, objv[3] ) != TCL_OK
+			|| setItemOptions ( interp, item, itemOptions ) != TCL_OK )
+	{
+		gnoclClearOptions ( itemOptions );
+		itemFree ( item );
+		return TCL_ERROR;
+	}
+
+	gnoclClearOptions ( itemOptions );
+
+	scene = getScene ( area, 1 );
+	item->id = scene->nextId++;
+	itemBBox ( scene, item );
+	g_hash_table_insert ( scene->items, GUINT_TO_POINTER ( item->id ), item );
+	sceneIndex ( scene, item, 1 );
+	sceneInvalidate ( scene, &item->bbox );
+
+	Tcl_SetObjResult ( interp, Tcl_NewIntObj ( item->id ) );
+
+	return TCL_OK;
+}
+
+/**
+\brief      Operations on single items of the display list.
+\note       <widgetId> item delete|move|coords|configure|bbox id ?args?
+            Only the old and new bounding boxes are repainted.
+**/
+static int sceneItem ( Tcl_Interp *interp, GtkWidget *area, int objc, Tcl_Obj * const objv[] )
+{
+	static const char *cmds[] = { "delete", "move", "coords", "configure", "bbox", NULL };
+	enum cmdIdx { DeleteIdx, MoveIdx, CoordsIdx, ConfigureIdx, BBoxIdx };
+
+	DrawScene *scene = getScene ( area, 0 );
+	DrawItem  *item = NULL;
+	int       idx, id;
+
+	if ( objc < 4 )
+	{
+		Tcl_WrongNumArgs ( interp, 2, objv, "subcommand id ?args?" );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_GetIndexFromObj ( interp, objv[2], cmds, "subcommand", TCL_EXACT, &idx ) != TCL_OK
+			|| Tcl_GetIntFromObj ( interp, objv[3], &id ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( scene != NULL )
+	{
+		item = g_hash_table_lookup ( scene->items, GUINT_TO_POINTER ( id ) );
+	}
+
+	if ( item == NULL )
+	{
+		Tcl_AppendResult ( interp, "Unknown item \"", Tcl_GetString ( objv[3] ), "\"", NULL );
+		return TCL_ERROR;
+	}
+
+	switch ( idx )
+	{
+		case DeleteIdx:
+			{
+				sceneIndex ( scene, item, 0 );
+				sceneInvalidate ( scene, &item->bbox );
+				g_hash_table_remove ( scene->items, GUINT_TO_POINTER ( id ) );
+			}
+
+			return TCL_OK;
+		case BBoxIdx:
+			{
+				Tcl_Obj *res = Tcl_NewListObj ( 0, NULL );
+
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewIntObj ( item->bbox.x ) );
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewIntObj ( item->bbox.y ) );
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewIntObj ( item->bbox.width ) );
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewIntObj ( item->bbox.height ) );
+				Tcl_SetObjResult ( interp, res );
+			}
+
+			return TCL_OK;
+		case CoordsIdx:
+			{
+				if ( objc == 4 )
+				{
+					Tcl_Obj *res = Tcl_NewListObj ( 0, NULL );
+					int     k;
+
+					for ( k = 0; k < item->noCoords; ++k )
+					{
+						Tcl_ListObjAppendElement ( interp, res, Tcl_NewDoubleObj ( item->coords[k] ) );
+					}
+
+					Tcl_SetObjResult ( interp, res );
+					return TCL_OK;
+				}
+
+				if ( objc != 5 )
+				{
+					Tcl_WrongNumArgs ( interp, 4, objv, "?coords?" );
+					return TCL_ERROR;
+				}
+			}
+
+			break;
+		case MoveIdx:
+			{
+				if ( objc != 6 )
+				{
+					Tcl_WrongNumArgs ( interp, 4, objv, "dx dy" );
+					return TCL_ERROR;
+				}
+			}
+
+			break;
+	}
+
+	/*  the remaining operations change the geometry */
+	sceneIndex ( scene, item, 0 );
+	sceneInvalidate ( scene, &item->bbox );
+
+	if ( idx == MoveIdx )
+	{
+		gdouble dx, dy;
+		int     k;
+
+		if ( Tcl_GetDoubleFromObj ( interp, objv[4], &dx ) != TCL_OK
+				|| Tcl_GetDoubleFromObj ( interp, objv[5], &dy ) != TCL_OK )
+		{
+			sceneIndex ( scene, item, 1 );
+			return TCL_ERROR;
+		}
+
+		/*  arcs and rectangles only have a position, the rest are sizes and angles */
+		int     no = ( item->type == RectangleIdx || item->type == ArcIdx ) ? 2 : item->noCoords;
+
+		for ( k = 0; k + 1 < no; k += 2 )
+		{
+			item->coords[k] += dx;
+			item->coords[k+1] += dy;
+		}
+	}
+
+	else if ( idx == CoordsIdx )
+	{
+		if ( setItemCoords ( interp, item, objv[4] ) != TCL_OK )
+		{
+			sceneIndex ( scene, item, 1 );
+			return TCL_ERROR;
+		}
+	}
+
+	else
+	{
+		int ret = gnoclParseOptions ( interp, objc - 3, objv + 3, itemOptions );
+
+		if ( ret == TCL_OK )
+		{
+			ret = setItemOptions ( interp, item, itemOptions );
+		}
+
+		gnoclClearOptions ( itemOptions );
+
+		if ( ret != TCL_OK )
+		{
+			sceneIndex ( scene, item, 1 );
+			return TCL_ERROR;
+		}
+	}
+
+	itemBBox ( scene, item );
+	sceneIndex ( scene, item, 1 );
+	sceneInvalidate ( scene, &item->bbox );
+
+	return TCL_OK;
+}
+
+/*
+    Bulk plotting.
+    Samples are reduced to at most four points per pixel column, the first,
+    the minimum, the maximum and the last, in the order they occurred. The
+    drawn shape is the same, but painting costs scale with the width of the
+    widget rather than with the number of samples.
+*/
+
+typedef struct
+{
+	GArray  *out;
+	int     n;              /* samples in the current column */
+	int     col;
+	gdouble x[4], y[4];     /* first, min, max and last sample of the column */
+	int     i[4];           /* their positions within the column */
+} Decimator;
+
+/**
+**/
+static void decimateFlush ( Decimator *d )
+{
+	int k, prev = -1;
+
+	/*  emit first, min and max in order of occurrence, then last */
+	int order[4] = { 0, d->i[1] <= d->i[2] ? 1 : 2, d->i[1] <= d->i[2] ? 2 : 1, 3 };
+
+	for ( k = 0; k < 4; ++k )
+	{
+		if ( d->i[order[k]] > prev )
+		{
+			prev = d->i[order[k]];
+			g_array_append_val ( d->out, d->x[order[k]] );
+			g_array_append_val ( d->out, d->y[order[k]] );
+		}
+	}
+
+	d->n = 0;
+}
+
+/**
+**/
+static void decimateAdd ( Decimator *d, gdouble x, gdouble y )
+{
+	int col = floor ( x );
+
+	if ( d->n > 0 && col != d->col )
+	{
+		decimateFlush ( d );
+	}
+
+	if ( d->n == 0 )
+	{
+		int k;
+
+		d->col = col;
+
+		for ( k = 0; k < 4; ++k )
+		{
+			d->x[k] = x;
+			d->y[k] = y;
+			d->i[k] = 0;
+		}
+	}
+
+	else
+	{
+		if ( y < d->y[1] )
+		{
+			d->x[1] = x; d->y[1] = y; d->i[1] = d->n;
+		}
+
+		if ( y > d->y[2] )
+		{
+			d->x[2] = x; d->y[2] = y; d->i[2] = d->n;
+		}
+
+		d->x[3] = x; d->y[3] = y; d->i[3] = d->n;
+	}
+
+	++d->n;
+}
+
+static const int plotPointsIdx = 0;
+static const int plotPackedIdx = 1;
+static const int plotStyleIdx = 2;
+static const int plotColorIdx = 3;
+static const int plotWidthIdx = 4;
+
+static GnoclOption plotOptions[] =
+{
+	{ "-points", GNOCL_OBJ, NULL },
+	{ "-packed", GNOCL_OBJ, NULL },
+	{ "-style", GNOCL_OBJ, NULL },
+	{ "-color", GNOCL_OBJ, NULL },
+	{ "-width", GNOCL_DOUBLE, NULL },
+	{ NULL }
+};
+
+/**
+\brief      Plot a series of samples, replacing an earlier series of that name.
+\note       <widgetId> plot name -points {x y x y ...} | -packed bytes ?-style line|points? ?-color c? ?-width w?
+            -packed takes a ByteArray of native float32 x y pairs.
+            Returns the id of the display list item holding the series.
+**/
+static int scenePlot ( Tcl_Interp *interp, GtkWidget *area, int objc, Tcl_Obj * const objv[] )
+{
+	static const char *styles[] = { "line", "points", NULL };
+
+	DrawScene *scene;
+	DrawItem  *item = NULL;
+	Decimator dec;
+	gdouble   color[4] = { 0, 0, 0, 1 };
+	int       style = 0;
+	int       ret = TCL_ERROR;
+
+	if ( objc < 5 )
+	{
+		Tcl_WrongNumArgs ( interp, 2, objv, "name -points list | -packed bytes ?-option val ...?" );
+		return TCL_ERROR;
+	}
+
+	if ( gnoclParseOptions ( interp, objc - 2, objv + 2, plotOptions ) != TCL_OK )
+	{
+		goto clearExit;
+	}
+
+	if ( ( plotOptions[plotPointsIdx].status == GNOCL_STATUS_CHANGED ) == ( plotOptions[plotPackedIdx].status == GNOCL_STATUS_CHANGED ) )
+	{
+		Tcl_SetResult ( interp, "exactly one of -points and -packed is required", TCL_STATIC );
+		goto clearExit;
+	}
+
+	if ( plotOptions[plotStyleIdx].status == GNOCL_STATUS_CHANGED
+			&& Tcl_GetIndexFromObj ( interp, plotOptions[plotStyleIdx].val.obj, styles, "style", TCL_EXACT, &style ) != TCL_OK )
+	{
+		goto clearExit;
+	}
+
+	if ( plotOptions[plotColorIdx].status == GNOCL_STATUS_CHANGED
+			&& getItemColor ( interp, plotOptions[plotColorIdx].val.obj, color ) != TCL_OK )
+	{
+		goto clearExit;
+	}
+
+	dec.out = g_array_new ( 0, 0, sizeof ( gdouble ) );
+	dec.n = 0;
+
+	if ( plotOptions[plotPointsIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		Tcl_Obj **elems;
+		int     k, no;
+		gdouble x, y;
+
+		if ( Tcl_ListObjGetElements ( interp, plotOptions[plotPointsIdx].val.obj, &no, &elems ) != TCL_OK )
+		{
+			goto freeExit;
+		}
+
+		if ( no % 2 )
+		{
+			Tcl_SetResult ( interp, "-points must contain x y pairs", TCL_STATIC );
+			goto freeExit;
+		}
+
+		for ( k = 0; k < no; k += 2 )
+		{
+			if ( Tcl_GetDoubleFromObj ( interp, elems[k], &x ) != TCL_OK
+					|| Tcl_GetDoubleFromObj ( interp, elems[k+1], &y ) != TCL_OK )
+			{
+				goto freeExit;
+			}
+
+			decimateAdd ( &dec, x, y );
+		}
+	}
+
+	else
+	{
+		int         k, len;
+		const float *p = ( const float * ) Tcl_GetByteArrayFromObj ( plotOptions[plotPackedIdx].val.obj, &len );
+
+		if ( len % ( 2 * sizeof ( float ) ) )
+		{
+			Tcl_SetResult ( interp, "-packed must contain float32 x y pairs", TCL_STATIC );
+			goto freeExit;
+		}
+
+		for ( k = 0; k < len / ( int ) sizeof ( float ); k += 2 )
+		{
+			decimateAdd ( &dec, p[k], p[k+1] );
+		}
+	}
+
+	if ( dec.n > 0 )
+	{
+		decimateFlush ( &dec );
+	}
+
+	if ( dec.out->len == 0 )
+	{
+		Tcl_SetResult ( interp, "no samples to plot", TCL_STATIC );
+		goto freeExit;
+	}
+
+	scene = getScene ( area, 1 );
+	item = g_hash_table_lookup ( scene->items, g_hash_table_lookup ( scene->series, Tcl_GetString ( objv[2] ) ) );
+
+	if ( item != NULL )
+	{
+		sceneIndex ( scene, item, 0 );
+		sceneInvalidate ( scene, &item->bbox );
+	}
+
+	else
+	{
+		item = g_new0 ( DrawItem, 1 );
+		item->id = scene->nextId++;
+		item->color[3] = 1;
+		item->width = 1;
+		g_hash_table_insert ( scene->items, GUINT_TO_POINTER ( item->id ), item );
+		g_hash_table_insert ( scene->series, g_strdup ( Tcl_GetString ( objv[2] ) ), GUINT_TO_POINTER ( item->id ) );
+	}
+
+	/*  a single sample can only be drawn as a point */
+	item->type = ( style == 1 || dec.out->len == 2 ) ? PointsIdx : LinesIdx;
+	g_free ( item->coords );
+	item->noCoords = dec.out->len;
+	item->coords = ( gdouble * ) g_array_free ( dec.out, 0 );
+	dec.out = NULL;
+
+	if ( plotOptions[plotColorIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		memcpy ( item->color, color, sizeof ( color ) );
+	}
+
+	if ( plotOptions[plotWidthIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		item->width = plotOptions[plotWidthIdx].val.d;
+	}
+
+	itemBBox ( scene, item );
+	sceneIndex ( scene, item, 1 );
+	sceneInvalidate ( scene, &item->bbox );
+
+	Tcl_SetObjResult ( interp, Tcl_NewIntObj ( item->id ) );
+	ret = TCL_OK;
+
+freeExit:
+
+	if ( dec.out != NULL )
+	{
+		g_array_free ( dec.out, 1 );
+	}
+
+clearExit:
+	gnoclClearOptions ( plotOptions );
+
+	return ret;
+}
+
+/**
+\brief      Remove all items and repaint.
+**/
+static void sceneErase ( GtkWidget *area )
+{
+	DrawScene *scene = getScene ( area, 0 );
+
+	if ( scene != NULL )
+	{
+		g_hash_table_remove_all ( scene->cells );
+		g_hash_table_remove_all ( scene->items );
+		g_hash_table_remove_all ( scene->series );
+		g_ptr_array_set_size ( scene->large, 0 );
+		areaInvalidate ( area, NULL );
+	}
+}
+
+/**
+/brief
+/author William J Giddings
+/date   2008-08
+**/
+int drawingAreaFunc ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+#ifdef DEBUG_DRAWING_AREA
+	g_printf ( "drawingAreaFunc\n" );
+	gint _i;
+
+	for ( _i = 0; _i < objc; _i++ )
+	{
+		g_printf ( "\targ %d = %s\n", _i,  Tcl_GetString ( objv[_i] ) );
+	}
+
+#endif
+
+	static const char *cmds[] =
+	{
+		"draw", "cget", "configure", "delete", "class", "erase", "option", "item",
+		"invalidate", "cacheStats", "plot", NULL
+	};
+	enum cmdIdx
+	{
+		DrawIdx, CgetIdx, ConfigureIdx, DeleteIdx, ClassIdx, EraseIdx, OptionIdx, ItemIdx,
+		InvalidateIdx, CacheStatsIdx, PlotIdx
+	};
+
+
+
+	/*
+	static const char *events[] =
+	{
+	    "expose",           "motion",           "motionHint",
+	    "buttonMotion",     "button1Motion",    "button2Motion",
+	    "button3Motion",    "buttonPress",      "buttonRelease",
+	    "keyPress",         "keyRelease",       "enter",
+	    "leave",            "focus",            "structure",
+	    "propertyChange",   "visibility",       "proximityIn",
+	    "proximityOut",     "substructure",     "scroll",
+	    "all", NULL
+	};
+	*/
+
+	GtkWidget *area = GTK_WIDGET ( data );
+
+	int idx;
+	int idx2;
+
+	if ( objc < 2 )
+	{
+		Tcl_WrongNumArgs ( interp, 1, objv, "command" );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_GetIndexFromObj ( interp, objv[1], cmds, "command", TCL_EXACT, &idx ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	switch ( idx )
+	{
+		case DrawIdx:
+			{
+				return sceneDraw ( interp, area, objc, objv );
+			}
+		case ItemIdx:
+			{
+				return sceneItem ( interp, area, objc, objv );
+			}
+		case PlotIdx:
+			{
+				return scenePlot ( interp, area, objc, objv );
+			}
+		case EraseIdx:
+			{
+				sceneErase ( area );
+			}
+
+			break;
+		case InvalidateIdx:
+			{
+				/*  <widgetId> invalidate ?{x y width height}? */
+				GdkRectangle rect;
+				Tcl_Obj *elems[4];
+				int k, v[4];
+
+				if ( objc == 2 )
+				{
+					areaInvalidate ( area, NULL );
+					break;
+				}
+
+				if ( objc != 3 )
+				{
+					Tcl_WrongNumArgs ( interp, 2, objv, "?rectangle?" );
+					return TCL_ERROR;
+				}
+
+				for ( k = 0; k < 4; ++k )
+				{
+					if ( Tcl_ListObjIndex ( interp, objv[2], k, elems + k ) != TCL_OK
+							|| elems[k] == NULL
+							|| Tcl_GetIntFromObj ( interp, elems[k], v + k ) != TCL_OK )
+					{
+						Tcl_SetResult ( interp, "rectangle must be a list of x y width height", TCL_STATIC );
+						return TCL_ERROR;
+					}
+				}
+
+				rect.x = v[0];
+				rect.y = v[1];
+				rect.width = v[2];
+				rect.height = v[3];
+				areaInvalidate ( area, &rect );
+			}
+
+			break;
+		case CacheStatsIdx:
+			{
+				/*  repaints run the expose handlers, blits are served from the cache */
+				SurfaceCache *cache = g_object_get_data ( G_OBJECT ( area ), "gnocl::surfaceCache" );
+				Tcl_Obj *res = Tcl_NewListObj ( 0, NULL );
+
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewStringObj ( "repaints", -1 ) );
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewIntObj ( cache ? cache->repaints : 0 ) );
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewStringObj ( "blits", -1 ) );
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewIntObj ( cache ? cache->blits : 0 ) );
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewStringObj ( "repaintTime", -1 ) );
+				Tcl_ListObjAppendElement ( interp, res, Tcl_NewDoubleObj ( cache ? cache->repaintTime * 1000 : 0 ) );
+				Tcl_SetObjResult ( interp, res );
+			}
+
+			break;
 		case OptionIdx:
 			{
 #ifdef DEBUG_DRAWING_AREA
@@ -305,7 +1814,7 @@ int gnoclDrawingAreaCmd (
 
 	gtk_widget_show ( GTK_WIDGET ( widget ) );
 
-	gnoclSetOptions ( interp, drawingAreaOptions, G_OBJECT ( widget ), -1 );
+	configure ( interp, GTK_DRAWING_AREA ( widget ), drawingAreaOptions );
 
 	gnoclClearOptions ( drawingAreaOptions );
 
@@ -40,6 +40,7 @@
 
 /*
    History:
+   2026-10-19: added -completion, -completionFile, -completionLimit, -completionMatch
    2009-06-13: added -align
    2009-04-27: added command setPosition
    2009-04-26: added -onInsertText -onKeyPress -onKeyRelease
@@ -110,6 +111,13 @@ static GnoclOption entryOptions[] =
 	{ "-onPaste", GNOCL_OBJ, "V", gnoclOptOnClipboard},
 	{ "-onPopuplatePopup", GNOCL_OBJ, "populate-popup", gnoclOptOnPopulatePopup},
 	{ "-onOverwrite", GNOCL_OBJ, "toggle-overwrite", gnoclOptOnToggleOverwrite},
+	{ "-variableSync", GNOCL_OBJ, "", gnoclOptVariableSync },
+
+	/* type-ahead completion, completion.c */
+	{ "-completion", GNOCL_OBJ, "", gnoclOptCompletion },
+	{ "-completionFile", GNOCL_OBJ, "", gnoclOptCompletionFile },
+	{ "-completionLimit", GNOCL_OBJ, "", gnoclOptCompletionLimit },
+	{ "-completionMatch", GNOCL_OBJ, "", gnoclOptCompletionMatch },
 
 	{ NULL }
 };
@@ -203,7 +211,12 @@ static char *traceFunc ( ClientData data, Tcl_Interp *interp,   const char *name
 
 	if ( para->inSetVar == 0 && name1 )
 	{
-		const char *txt = name1 ? Tcl_GetVar2 ( interp, name1, name2, 0 ) : NULL;
+		const char *txt;
+
+		if ( gnoclVarSyncDefer ( G_OBJECT ( para->entry ), traceFunc, data, interp, para->variable ) )
+			return NULL;
+
+		txt = Tcl_GetVar2 ( interp, name1, name2, 0 );
 
 		if ( txt )
 		{
@@ -90,6 +90,8 @@ This manual is divided in the following sections:
     \verbatim
 
     These are some old details from gnocl.c
+   2026-10:    added gnocl::worker, gnocl refuses to load outside the GUI thread
+   2026-10:    gnocl::inventory lists in id order, added -class, -toplevel, -pattern
    2010-12-13: added gnocl::inventory
    2009-12-31: added gnocl::beep
    2009-12-29: added support for GtkRecentChooserWidget
@@ -282,6 +284,22 @@ This manual is divided in the following sections:
 static GHashTable *name2widgetList;
 static const char idPrefix[] = "::gnocl::_WID";
 
+/*  key of the widget name, set by gnoclMemNameAndWidget */
+static GQuark nameQuark;
+
+/*  changes whenever a widget leaves the registry, invalidating cached handles */
+static gulong registryGeneration = 1;
+
+/*  a widget name with the widget and registry generation of the last lookup */
+static Tcl_ObjType widgetHandleType =
+{
+	"gnoclWidget",
+	NULL,
+	NULL,
+	NULL,
+	NULL
+};
+
 /**
 \brief      Convert contents of hash list to a glist
 \author     William J Giddings
@@ -336,6 +354,11 @@ int gnoclRegisterWidget ( Tcl_Interp *interp, GtkWidget *widget, Tcl_ObjCmdProc
 	if ( proc != NULL )
 	{
 		Tcl_CreateObjCommand ( interp, ( char * ) name, proc, widget, NULL );
+
+		if ( gnoclProfiling )
+		{
+			gnoclProfileWrapCommand ( interp, name );
+		}
 	}
 
 	Tcl_SetObjResult ( interp, Tcl_NewStringObj ( name, -1 ) );
@@ -436,6 +459,39 @@ GtkWidget *gnoclGetWidgetFromName ( const char *id, Tcl_Interp *interp )
 	return widget;
 }
 
+/**
+\brief      Like gnoclGetWidgetFromName, but caches the result in obj.
+\date       2026-10
+\note       Repeated lookups with the same object only compare the registry
+            generation, which changes as soon as any widget is destroyed.
+**/
+GtkWidget *gnoclGetWidgetFromObj ( Tcl_Interp *interp, Tcl_Obj *obj )
+{
+	GtkWidget *widget;
+
+	if ( obj->typePtr == &widgetHandleType
+			&& GPOINTER_TO_SIZE ( obj->internalRep.twoPtrValue.ptr2 ) == registryGeneration )
+	{
+		return obj->internalRep.twoPtrValue.ptr1;
+	}
+
+	widget = gnoclGetWidgetFromName ( Tcl_GetString ( obj ), interp );
+
+	if ( widget != NULL )
+	{
+		if ( obj->typePtr != NULL && obj->typePtr->freeIntRepProc != NULL )
+		{
+			obj->typePtr->freeIntRepProc ( obj );
+		}
+
+		obj->internalRep.twoPtrValue.ptr1 = widget;
+		obj->internalRep.twoPtrValue.ptr2 = GSIZE_TO_POINTER ( registryGeneration );
+		obj->typePtr = &widgetHandleType;
+	}
+
+	return widget;
+}
+
 /**
 \brief      Returns the widget name associated with pointer
 \author     Peter G Baum
@@ -444,7 +500,7 @@ GtkWidget *gnoclGetWidgetFromName ( const char *id, Tcl_Interp *interp )
 */
 const char *gnoclGetNameFromWidget ( GtkWidget *widget )
 {
-	const char *name = g_object_get_data ( G_OBJECT ( widget ), "gnocl::name" );
+	const char *name = g_object_get_qdata ( G_OBJECT ( widget ), nameQuark );
 
 	if ( name == NULL && ( GTK_IS_TREE_VIEW ( widget ) || GTK_IS_TEXT_VIEW ( widget ) ) )
 	{
@@ -470,7 +526,7 @@ int gnoclMemNameAndWidget ( const char *path,  GtkWidget *widget )
 	assert ( strncmp ( path, idPrefix, sizeof ( idPrefix ) - 1 ) == 0 );
 
 	/* memorize the name of the widget in the widget */
-	g_object_set_data ( G_OBJECT ( widget ), "gnocl::name", ( char * ) path );
+	g_object_set_qdata ( G_OBJECT ( widget ), nameQuark, ( char * ) path );
 	g_hash_table_insert ( name2widgetList, GINT_TO_POINTER ( n ), widget );
 
 	return 0;
@@ -489,71 +545,154 @@ int gnoclForgetWidgetFromName ( const char *path )
 	assert ( n > 0 );
 
 	g_hash_table_remove ( name2widgetList, GINT_TO_POINTER ( n ) );
+	++registryGeneration;
 
 	return 0;
 }
 
+/**
+\brief      Call func with the id number and widget of every registered widget.
+**/
+void gnoclForeachWidget ( GHFunc func, gpointer data )
+{
+	g_hash_table_foreach ( name2widgetList, func, data );
+}
+
+/*  id and object of a registry entry, see gnoclGetInventory */
+typedef struct
+{
+	gint     id;
+	gpointer obj;
+} InventoryEntry;
+
+/**
+**/
+static void hashToEntries ( gpointer key, gpointer value, gpointer user_data )
+{
+	InventoryEntry entry = { GPOINTER_TO_INT ( key ), value };
+
+	g_array_append_val ( ( GArray * ) user_data, entry );
+}
+
+/**
+**/
+static int compareEntries ( const void *a, const void *b )
+{
+	return ( ( const InventoryEntry * ) a )->id - ( ( const InventoryEntry * ) b )->id;
+}
+
 /**
 \brief      Return a list of all names in the specific hash lists.
 \author     William J Giddings
 \date       12/03/10
 \since      0.9.94g
+\note       gnocl::inventory widget|pixBuf ?-class typeName? ?-toplevel bool? ?-pattern glob?
+            The names are listed in order of creation. -class selects widgets
+            of a GType and its subclasses, -toplevel toplevel or other widgets.
 **/
-const char *gnoclGetInventory ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+int gnoclGetInventory ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 {
-
-	gint _i;
-
 	static const char *cmds[] = { "widget", "pixBuf", NULL };
 	enum optIdx { WidgetIdx, PixBufIdx };
-	int idx;
 
+	GnoclOption options[] =
+	{
+		{ "-class", GNOCL_STRING, NULL },
+		{ "-toplevel", GNOCL_BOOL, NULL },
+		{ "-pattern", GNOCL_STRING, NULL },
+		{ NULL }
+	};
+	const int classIdx = 0;
+	const int toplevelIdx = 1;
+	const int patternIdx = 2;
+
+	GArray   *entries;
+	Tcl_Obj  **names;
+	GType    type = 0;
+	guint    k;
+	int      idx, no = 0;
+
+	if ( objc < 2 )
+	{
+		Tcl_WrongNumArgs ( interp, 1, objv, "widget|pixBuf ?-option val ...?" );
+		return TCL_ERROR;
+	}
 
 	if ( Tcl_GetIndexFromObj ( interp, objv[1], cmds, "command", TCL_EXACT, &idx ) != TCL_OK )
 	{
-		Tcl_WrongNumArgs ( interp, 1, objv, "[widget | pixBuf]\n" );
 		return TCL_ERROR;
 	}
 
-	GList *list;
-	GList *l;
-	GString *str;
+	if ( gnoclParseOptions ( interp, objc - 1, objv + 1, options ) != TCL_OK )
+	{
+		gnoclClearOptions ( options );
+		return TCL_ERROR;
+	}
 
+	if ( idx == PixBufIdx && ( options[classIdx].status == GNOCL_STATUS_CHANGED
+							   || options[toplevelIdx].status == GNOCL_STATUS_CHANGED ) )
+	{
+		Tcl_SetResult ( interp, "pixBuf only supports -pattern", TCL_STATIC );
+		gnoclClearOptions ( options );
+		return TCL_ERROR;
+	}
 
-	str = g_string_new ( "" );
+	if ( options[classIdx].status == GNOCL_STATUS_CHANGED
+			&& ( type = g_type_from_name ( options[classIdx].val.str ) ) == 0 )
+	{
+		Tcl_AppendResult ( interp, "Unknown class \"", options[classIdx].val.str, "\"", NULL );
+		gnoclClearOptions ( options );
+		return TCL_ERROR;
+	}
 
-	list = NULL;
+	entries = g_array_new ( 0, 0, sizeof ( InventoryEntry ) );
 
+	if ( idx == WidgetIdx )
+	{
+		g_hash_table_foreach ( name2widgetList, hashToEntries, entries );
+	}
 
-	switch ( idx )
+	else
 	{
-		case WidgetIdx:
-			{
-				g_hash_table_foreach ( name2widgetList, hash_to_list, &list );
-				list = g_list_sort ( list, sorter );
+		gnoclForeachPixBuf ( hashToEntries, entries );
+	}
 
-				for ( l = list; l != NULL; l = l->next )
-				{
-					str = g_string_append ( str, gnoclGetNameFromWidget ( l->data ) );
-					str = g_string_append ( str, " " );
-				}
+	qsort ( entries->data, entries->len, sizeof ( InventoryEntry ), compareEntries );
+	names = ( Tcl_Obj ** ) ckalloc ( sizeof ( Tcl_Obj * ) * ( entries->len + 1 ) );
 
-			} break;
-		case PixBufIdx:
-			{
-				gnoclGetPixBufList ( &list );
-				list = g_list_sort ( list, sorter );
+	for ( k = 0; k < entries->len; ++k )
+	{
+		GObject    *obj = g_array_index ( entries, InventoryEntry, k ).obj;
+		const char *name;
 
-				for ( l = list; l != NULL; l = l->next )
-				{
-					str = g_string_append ( str, gnoclGetNameFromPixBuf ( l->data ) );
-					str = g_string_append ( str, " " );
-				}
-			} break;
-		default: {} break;
+		if ( type != 0 && !g_type_is_a ( G_OBJECT_TYPE ( obj ), type ) )
+		{
+			continue;
+		}
+
+		if ( options[toplevelIdx].status == GNOCL_STATUS_CHANGED
+				&& options[toplevelIdx].val.b != ( GTK_IS_WIDGET ( obj ) && GTK_WIDGET_TOPLEVEL ( obj ) ) )
+		{
+			continue;
+		}
+
+		name = idx == WidgetIdx ? g_object_get_qdata ( obj, nameQuark ) : gnoclGetNameFromPixBuf ( GDK_PIXBUF ( obj ) );
+
+		if ( name == NULL || ( options[patternIdx].status == GNOCL_STATUS_CHANGED
+							   && !Tcl_StringMatch ( name, options[patternIdx].val.str ) ) )
+		{
+			continue;
+		}
+
+		names[no++] = Tcl_NewStringObj ( name, -1 );
 	}
 
-	Tcl_SetResult ( interp, str->str, TCL_STATIC );
+	Tcl_SetObjResult ( interp, Tcl_NewListObj ( no, names ) );
+
+	ckfree ( ( char * ) names );
+	g_array_free ( entries, 1 );
+	gnoclClearOptions ( options );
+
 	return TCL_OK;
 }
 
@@ -923,10 +1062,12 @@ static GnoclCmd commands[] =
 	{ "debug",           gnoclDebugCmd },
 	{ "callback",        gnoclCallbackCmd },
 	{ "clipboard",       gnoclClipboardCmd },
+	{ "worker",          gnoclWorkerCmd },
 	{ "configure",       gnoclConfigureCmd },
 	{ "info",            gnoclInfoCmd },
 	{ "mainLoop",        gnoclMainLoop },
 	{ "update",          gnoclUpdateCmd },
+	{ "build",           gnoclBuildCmd },
 	{ "resourceFile",    gnoclResourceFileCmd },
 	{ "winfo",           gnoclWinfoCmd },
 	{ "print",           gnoclPrintCmd },
@@ -1153,7 +1294,18 @@ static int eventProc ( Tcl_Event *evPtr, int flags )
 	   the event can have been handled by the gtk event loop if we
 	   are in mainLoop
 	*/
-	gtk_main_iteration_do ( 0 );
+	if ( gnoclFrameStats )
+	{
+		gnoclFramePush ( GNOCL_FRAME_EVENTS );
+		gtk_main_iteration_do ( 0 );
+		gnoclFramePop ();
+	}
+
+	else
+	{
+		gtk_main_iteration_do ( 0 );
+	}
+
 	return 1;
 }
 
@@ -1311,6 +1463,13 @@ GtkAccelGroup *gnoclGetAccelGroup( )
 static gint tclTimerFunc ( gpointer data )
 {
 	/* Tcl_Interp *interp = (Tcl_Interp *)data; */
+	int frameStats = gnoclFrameStats;
+
+	if ( frameStats )
+	{
+		gnoclFramePush ( GNOCL_FRAME_TCL );
+	}
+
 	while ( Tcl_DoOneEvent ( TCL_DONT_WAIT ) )
 	{
 		/* printf( "t" ); fflush( stdout ); */
@@ -1320,6 +1479,11 @@ static gint tclTimerFunc ( gpointer data )
 		}
 	}
 
+	if ( frameStats )
+	{
+		gnoclFramePop ();
+	}
+
 	/* TODO: or Tcl_ServiceAll(); ? */
 	return 1;
 }
@@ -1479,6 +1643,7 @@ int Gnocl_Init ( Tcl_Interp *interp )
 	int argc;
 	char **argv;
 	char **argvp;
+	static Tcl_ThreadId guiThread = NULL;
 
 	/* printf( "Initializing gnocl version %s\n", VERSION ); */
 
@@ -1487,6 +1652,27 @@ int Gnocl_Init ( Tcl_Interp *interp )
 		return TCL_ERROR;
 	}
 
+	/* gtk and the gnocl tables are not thread safe, other threads use gnocl::worker */
+	if ( guiThread == NULL )
+	{
+		guiThread = Tcl_GetCurrentThread ();
+	}
+
+	else if ( guiThread != Tcl_GetCurrentThread () )
+	{
+		Tcl_SetResult ( interp, "GNOCL ERROR: gnocl can only be loaded into the GUI thread.", TCL_STATIC );
+		return TCL_ERROR;
+	}
+
+#if !GLIB_CHECK_VERSION(2,32,0)
+
+	if ( !g_thread_supported () )
+	{
+		g_thread_init ( NULL );
+	}
+
+#endif
+
 	/* TODO? set locale before every jump to Tcl? */
 	Tcl_PutEnv ( "LC_NUMERIC=C" );
 
@@ -1517,6 +1703,7 @@ int Gnocl_Init ( Tcl_Interp *interp )
 
 	/* initialize the hash table to contain list of pointers to named widgets */
 	name2widgetList = g_hash_table_new ( g_direct_hash, g_direct_equal );
+	nameQuark = g_quark_from_static_string ( "gnocl::name" );
 	
 	/* FIXME: is there a more elegant way? */
 	/*        use gtk_idle_add( tclTimerFunc, NULL ); ? */
@@ -65,7 +65,10 @@ int gnoclRegisterWidget ( Tcl_Interp *interp, GtkWidget *widget,
 						  Tcl_ObjCmdProc *proc );
 
 /* WJG Added 05-03-09 */
-int gnoclRegisterPixbuf ( Tcl_Interp *interp, GdkPixbuf *pixbuf, Tcl_ObjCmdProc *proc );
+int gnoclRegisterPixBuf ( Tcl_Interp *interp, GdkPixbuf *pixbuf, Tcl_ObjCmdProc *proc );
+const char *gnoclGetNameFromPixBuf ( GdkPixbuf *pixbuf );
+GdkPixbuf *gnoclGetPixBufFromName ( const char *id, Tcl_Interp *interp );
+void gnoclForeachPixBuf ( GHFunc func, gpointer data );
 
 
 int gnoclMemNameAndWidget ( const char *name, GtkWidget *widget );
@@ -73,6 +76,8 @@ int gnoclForgetWidgetFromName ( const char *name );
 char *gnoclGetAutoWidgetId ( void );
 const char *gnoclGetNameFromWidget ( GtkWidget *widget );
 GtkWidget *gnoclGetWidgetFromName ( const char *name, Tcl_Interp *interp );
+GtkWidget *gnoclGetWidgetFromObj ( Tcl_Interp *interp, Tcl_Obj *obj );
+void gnoclForeachWidget ( GHFunc func, gpointer data );
 GtkWidget *gnoclChildNotPacked ( const char *name, Tcl_Interp *interp );
 int gnoclAssertNotPacked ( GtkWidget *child, Tcl_Interp *interp,
 						   const char *name );
@@ -187,6 +192,13 @@ gnoclOptFunc gnoclOptBothAlign;
 gnoclOptFunc gnoclOptChild;
 gnoclOptFunc gnoclOptCommand;
 gnoclOptFunc gnoclOptData;
+gnoclOptFunc gnoclOptVariableSync;
+
+/* in completion.c, for entry and comboEntry */
+gnoclOptFunc gnoclOptCompletion;
+gnoclOptFunc gnoclOptCompletionFile;
+gnoclOptFunc gnoclOptCompletionLimit;
+gnoclOptFunc gnoclOptCompletionMatch;
 gnoclOptFunc gnoclOptDnDTargets;
 gnoclOptFunc gnoclOptGdkColor;
 gnoclOptFunc gnoclOptGdkBaseFont;
@@ -384,6 +396,23 @@ int gnoclAttacheOptCmdAndVar ( GnoclOption *newCmd, char **oldCmd,
 							   GObject *obj, GCallback gtkFunc,
 							   Tcl_Interp *interp, Tcl_VarTraceProc tclFunc,
 							   gpointer data );
+
+/* in helperFuncs, -variableSync: traces of deferred widgets apply once per frame */
+enum GnoclVarSync
+{
+	GNOCL_VARSYNC_DEFAULT,
+	GNOCL_VARSYNC_IMMEDIATE,
+	GNOCL_VARSYNC_DEFERRED
+};
+
+int gnoclGetVarSync ( Tcl_Interp *interp, Tcl_Obj *obj, enum GnoclVarSync *mode );
+void gnoclSetVarSyncDefault ( enum GnoclVarSync mode );
+Tcl_Obj *gnoclVarSyncInfo ( void );
+int gnoclVarSyncDefer ( GObject *obj, Tcl_VarTraceProc *proc, ClientData data,
+						Tcl_Interp *interp, const char *variable );
+void gnoclVarSyncCancel ( ClientData data );
+void gnoclVarSyncFlush ( void );
+gint64 gnoclMonotonicTime ( void );
 int gnoclGetScrollbarPolicy ( Tcl_Interp *interp, Tcl_Obj *obj,
 							  GtkPolicyType *hor, GtkPolicyType *vert );
 int gnoclGetSelectionMode ( Tcl_Interp *interp, Tcl_Obj *obj,
@@ -392,6 +421,7 @@ int gnoclGetFontTxt ( Tcl_Interp *interp, Tcl_Obj *obj, const char **font );
 int gnoclGetGdkFont ( Tcl_Interp *interp, Tcl_Obj *obj, GdkFont **font );
 int gnoclGetGdkColorAlloc ( Tcl_Interp *interp, Tcl_Obj *obj,
 							GtkWidget *widget, GdkColor *color, int *a );
+int gnoclGetRGBA ( Tcl_Interp *interp, Tcl_Obj *obj, int *r, int *g, int *b, int *a );
 int gnoclGetAnchorStyle ( Tcl_Interp *interp, Tcl_Obj *obj,
 						  GtkAnchorType *style );
 int gnoclGetJustification ( Tcl_Interp *interp, Tcl_Obj *obj,
@@ -418,6 +448,37 @@ GtkWidget *gnoclFindChild ( GtkWidget *widget, GtkType type );
 int gnoclPosOffset ( Tcl_Interp *interp, const char *txt, int *offset );
 int gnoclPercentSubstAndEval ( Tcl_Interp *interp, GnoclPercSubst *ps,
 							   const char *orig_script, int background );
+
+/* debug.c, profiler hooks; gnoclProfiling is only set while a profile or frameStats runs */
+enum GnoclProfileKind
+{
+	GNOCL_PROFILE_SCRIPT,
+	GNOCL_PROFILE_CALLBACK,
+	GNOCL_PROFILE_WIDGET,
+	GNOCL_PROFILE_KINDS
+};
+
+typedef struct GnoclProfileStat GnoclProfileStat;
+
+/* debug.c, main loop time categories of gnocl::debug frameStats */
+enum GnoclFrameKind
+{
+	GNOCL_FRAME_EVENTS,
+	GNOCL_FRAME_PAINT,
+	GNOCL_FRAME_TCL,
+	GNOCL_FRAME_IDLE,
+	GNOCL_FRAME_OTHER,
+	GNOCL_FRAME_KINDS
+};
+
+extern int gnoclFrameStats;
+void gnoclFramePush ( enum GnoclFrameKind kind );
+void gnoclFramePop ( void );
+
+extern int gnoclProfiling;
+GnoclProfileStat *gnoclProfileBegin ( enum GnoclProfileKind kind, const char *key, gint64 *start );
+void gnoclProfileEnd ( GnoclProfileStat *stat, gint64 start );
+void gnoclProfileWrapCommand ( Tcl_Interp *interp, const char *name );
 int gnoclGet2Boolean ( Tcl_Interp *interp, Tcl_Obj *obj, int *b1, int *b2 );
 int gnoclGet2Int ( Tcl_Interp *interp, Tcl_Obj *obj, int *b1, int *b2 );
 int gnoclGet2Double ( Tcl_Interp *interp, Tcl_Obj *obj, double *b1, double *b2 );
@@ -444,6 +505,8 @@ int gnoclMenuItemHandleText ( Tcl_Interp *interp, GtkMenuItem *item,
 /* in text.c */
 int gnoclTextCommand ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc,
 					   Tcl_Obj * const objv[], int cmdNo, int allowDeleteConfigure );
+GtkTextTagTable *gnoclGetTagTable ( const char *name );
+int gnoclCheckTagTable ( Tcl_Interp *interp, GtkTextBuffer *buffer, const char *name );
 
 /* in sourceVSiew.c */
 
@@ -537,6 +600,7 @@ int gnoclFolderChooserButtonCmd ( ClientData data, Tcl_Interp *interp, int objc,
  * WJG 16/07/08
  */
 int gnoclDrawingAreaCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] );
+int gnoclExposeFromCache ( GtkWidget *widget, GdkEventExpose *event );
 
 void gnoclToggleDestroyFunc ( GtkWidget *widget, gpointer data );
 int gnoclToggleToggle ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[], GnoclToggleParams *para );
@@ -586,12 +650,16 @@ int gnoclCheckVariableValueChanged ( GnoclCheckParams *para );
 
 /* in radioButton.c  for menuRadioItem */
 
+typedef struct _GnoclRadioParams GnoclRadioParams;
+
 typedef struct
 {
-	Tcl_Interp *interp;
-	GArray     *widgets;
-	int        inSetVar;
-	char       *variable;
+	Tcl_Interp       *interp;
+	GArray           *widgets;
+	GHashTable       *values;   /* onValue string -> member */
+	GnoclRadioParams *active;   /* member currently switched on, or NULL */
+	int              inSetVar;
+	char             *variable;
 	/* GSList    *gtkGroup; */
 } GnoclRadioGroup;
 
@@ -599,14 +667,15 @@ typedef struct
  * radioButton declarations
  */
 
-typedef struct
+struct _GnoclRadioParams
 {
 	char            *name;
 	GnoclRadioGroup *group;
 	GtkWidget       *widget;
 	char            *onToggled;
 	Tcl_Obj         *onValue;
-} GnoclRadioParams;
+	guint           member;     /* position in group->widgets */
+};
 
 
 /*
@@ -634,11 +703,13 @@ int gnoclRadioOnToggled ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[],
 Tcl_ObjCmdProc gnoclDebugCmd;
 Tcl_ObjCmdProc gnoclCallbackCmd;
 Tcl_ObjCmdProc gnoclClipboardCmd;
+Tcl_ObjCmdProc gnoclWorkerCmd;
 
 Tcl_ObjCmdProc gnoclConfigureCmd;
 Tcl_ObjCmdProc gnoclInfoCmd;
 Tcl_ObjCmdProc gnoclMainLoop;
 Tcl_ObjCmdProc gnoclUpdateCmd;
+Tcl_ObjCmdProc gnoclBuildCmd;
 
 Tcl_ObjCmdProc gnoclResourceFileCmd;
 Tcl_ObjCmdProc gnoclWinfoCmd;
@@ -738,7 +809,7 @@ Tcl_ObjCmdProc gnoclAppBarCmd;
 
 /* the following constructors now need to be made public in order to run glade */
 
-int setGtkWidgetFunc ( Tcl_Interp *interp, GtkWidget *widget, int idx, Tcl_Obj *resList , gchar *gladeName, char *name );
+int setGtkWidgetFunc ( Tcl_Interp *interp, GtkWidget *widget, int idx, Tcl_Obj *resList , gchar *gladeName, int lazy );
 
 typedef int ( gnoclWidgetFunc ) ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] );
 
@@ -793,6 +864,7 @@ gnoclWidgetFunc panedFunc;
 gnoclWidgetFunc notebookFunc;
 gnoclWidgetFunc eventBoxFunc;
 gnoclWidgetFunc fileChooserFunc;
+gnoclWidgetFunc pixBufFunc;
 
 /* whole block removed into gnoclparams.h */
 
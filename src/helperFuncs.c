@@ -23,6 +23,8 @@
 
 /*
    History:
+   2026-10: gnoclMonotonicTime
+   2026-10: deferred variable synchronisation, gnoclVarSyncDefer
    2009-01: added getIdx
    2009-01: added gnoclGetWigdetGeometry
         05: added gnoclPosOffset from text.c
@@ -47,6 +49,26 @@ typedef struct
 } FindWidgetStruct;
 
 
+/**
+\brief     Microseconds from a clock that does not jump with the system time.
+\date      2026-10
+\note      For durations and deadlines only, the origin is unspecified.
+            GLib before 2.28 has no monotonic clock, there the wall clock
+            is used.
+**/
+gint64 gnoclMonotonicTime ( void )
+{
+#if GLIB_CHECK_VERSION(2,28,0)
+	return g_get_monotonic_time ();
+#else
+	GTimeVal tv;
+
+	g_get_current_time ( &tv );
+
+	return ( gint64 ) tv.tv_sec * G_USEC_PER_SEC + tv.tv_usec;
+#endif
+}
+
 /**
 /brief    Compare string with list of acceptable choices.
           Return index of any match.
@@ -68,6 +90,8 @@ int compare ( char *str, char *choices[] )
 			return i;
 		}
 	}
+
+	return -1;
 }
 
 /**
@@ -215,6 +239,8 @@ int gnoclPercentSubstAndEval ( Tcl_Interp *interp, GnoclPercSubst *ps, const cha
 	const char *perc;
 	GString    *script = g_string_sized_new ( len + 20 );
 	int        ret;
+	GnoclProfileStat *profStat;
+	gint64     profStart;
 
 	for ( ; ( perc = strchr ( old_perc, '%' ) ) != NULL; old_perc = perc + 2 )
 	{
@@ -328,7 +354,15 @@ int gnoclPercentSubstAndEval ( Tcl_Interp *interp, GnoclPercSubst *ps, const cha
 
 	/* Tcl_EvalObj would be faster and more elegant, but incompatible: eg.
 	two consecutive percent substitutions without space */
+	/* keyed by the unsubstituted script, which is the same for every call */
+	profStat = gnoclProfiling ? gnoclProfileBegin ( GNOCL_PROFILE_SCRIPT, orig_script, &profStart ) : NULL;
 	ret = Tcl_EvalEx ( interp, script->str, -1, TCL_EVAL_GLOBAL | TCL_EVAL_DIRECT );
+
+	if ( profStat != NULL )
+	{
+		gnoclProfileEnd ( profStat, profStart );
+	}
+
 #ifdef DEBUG
 	printf ( "\t4) DEBUG: script in percEval: %s -> %d %s\n", script->str, ret, Tcl_GetString ( Tcl_GetObjResult ( interp ) ) );
 #endif
@@ -348,8 +382,11 @@ int gnoclAttacheVariable ( GnoclOption *newVar, char **oldVar, const char *signa
 						   GCallback gtkFunc, Tcl_Interp *interp, Tcl_VarTraceProc tclFunc, gpointer data )
 {
 	if ( *oldVar && ( newVar == NULL || newVar->status == GNOCL_STATUS_CHANGED ) )
+	{
 		Tcl_UntraceVar ( interp, *oldVar, TCL_TRACE_WRITES | TCL_GLOBAL_ONLY,
 						 tclFunc, data );
+		gnoclVarSyncCancel ( data );
+	}
 
 	if ( newVar == NULL || newVar->status != GNOCL_STATUS_CHANGED
 			|| newVar->val.str[0] == 0 )
@@ -382,6 +419,229 @@ int gnoclAttacheVariable ( GnoclOption *newVar, char **oldVar, const char *signa
 	return TCL_OK;
 }
 
+/* a variable write waiting for the next frame */
+typedef struct
+{
+	GObject          *obj;
+	Tcl_VarTraceProc *proc;
+	ClientData       data;
+	Tcl_Interp       *interp;
+	gchar            *variable;     /* fully qualified name the trace is on */
+} VarSyncWrite;
+
+static const char *varSyncNames[] = { "immediate", "deferred", NULL };
+static enum GnoclVarSync varSyncDefault = GNOCL_VARSYNC_IMMEDIATE;
+static GHashTable *varSyncPending = NULL;
+static guint varSyncSource = 0;
+static int varSyncApplying = 0;
+static guint varSyncWrites = 0;
+static guint varSyncApplied = 0;
+static guint varSyncSkipped = 0;
+
+/**
+\brief     Read immediate|deferred.
+\date      2026-10
+**/
+int gnoclGetVarSync ( Tcl_Interp *interp, Tcl_Obj *obj, enum GnoclVarSync *mode )
+{
+	int idx;
+
+	if ( Tcl_GetIndexFromObj ( interp, obj, varSyncNames, "sync mode", TCL_EXACT, &idx ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	*mode = idx == 0 ? GNOCL_VARSYNC_IMMEDIATE : GNOCL_VARSYNC_DEFERRED;
+
+	return TCL_OK;
+}
+
+/**
+\brief     Mode of widgets without their own -variableSync, gnocl::configure -variableSync
+\date      2026-10
+**/
+void gnoclSetVarSyncDefault ( enum GnoclVarSync mode )
+{
+	varSyncDefault = mode;
+}
+
+/**
+\brief     {mode deferred writes n applied n skipped n}, gnocl::info variableSync
+\date      2026-10
+**/
+Tcl_Obj *gnoclVarSyncInfo ( void )
+{
+	Tcl_Obj *res = Tcl_NewListObj ( 0, NULL );
+
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewStringObj ( "mode", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewStringObj ( varSyncNames[varSyncDefault == GNOCL_VARSYNC_DEFERRED], -1 ) );
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewStringObj ( "writes", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewIntObj ( varSyncWrites ) );
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewStringObj ( "applied", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewIntObj ( varSyncApplied ) );
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewStringObj ( "skipped", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, res, Tcl_NewIntObj ( varSyncSkipped ) );
+
+	return res;
+}
+
+static void varSyncWriteFree ( VarSyncWrite *write )
+{
+	g_free ( write->variable );
+	g_free ( write );
+}
+
+/* the widget is gone, its pending write with it */
+static void varSyncObjGone ( gpointer data, GObject *where )
+{
+	VarSyncWrite *write = data;
+
+	write->obj = NULL;
+
+	if ( g_hash_table_lookup ( varSyncPending, write->data ) == write )
+	{
+		g_hash_table_remove ( varSyncPending, write->data );
+		varSyncWriteFree ( write );
+	}
+}
+
+static void varSyncCollect ( gpointer key, gpointer value, gpointer data )
+{
+	GSList **list = data;
+	*list = g_slist_prepend ( *list, value );
+}
+
+/**
+\brief     Apply the last value of each deferred variable, runs just before redraw.
+\date      2026-10
+**/
+static gboolean varSyncApply ( gpointer data )
+{
+	GSList *list = NULL;
+	GSList *p;
+
+	varSyncSource = 0;
+
+	/* traces run below may defer new writes for the next frame */
+	g_hash_table_foreach ( varSyncPending, varSyncCollect, &list );
+	g_hash_table_steal_all ( varSyncPending );
+
+	for ( p = list; p != NULL; p = p->next )
+	{
+		VarSyncWrite *write = p->data;
+
+		/* an earlier trace may have destroyed this widget */
+		if ( write->obj != NULL )
+		{
+			g_object_weak_unref ( write->obj, varSyncObjGone, write );
+
+			varSyncApplying = 1;
+			write->proc ( write->data, write->interp, write->variable, NULL, TCL_TRACE_WRITES | TCL_GLOBAL_ONLY );
+			varSyncApplying = 0;
+			++varSyncApplied;
+		}
+
+		varSyncWriteFree ( write );
+	}
+
+	g_slist_free ( list );
+
+	return FALSE;
+}
+
+/**
+\brief     Apply pending writes now, gnocl::update -idletasks|-redrawOnly
+\date      2026-10
+**/
+void gnoclVarSyncFlush ( void )
+{
+	if ( varSyncSource != 0 )
+	{
+		g_source_remove ( varSyncSource );
+		varSyncApply ( NULL );
+	}
+}
+
+/**
+\brief     Called first thing by a variable trace which would update obj.
+            Returns 1 if the update was deferred, the trace returns then.
+\date      2026-10
+\note      Writes to the same variable in one frame are coalesced, the trace
+            runs once with the final value. It is replayed at global level
+            with variable, the name the trace was set on, since the name1
+            the trace received may be local to an upvar or namespace frame.
+**/
+int gnoclVarSyncDefer ( GObject *obj, Tcl_VarTraceProc *proc, ClientData data,
+						Tcl_Interp *interp, const char *variable )
+{
+	enum GnoclVarSync mode = GPOINTER_TO_INT ( g_object_get_data ( obj, "gnocl::variableSync" ) );
+	VarSyncWrite *write;
+
+	if ( varSyncApplying )
+	{
+		return 0;
+	}
+
+	++varSyncWrites;
+
+	if ( mode == GNOCL_VARSYNC_DEFAULT )
+	{
+		mode = varSyncDefault;
+	}
+
+	if ( mode != GNOCL_VARSYNC_DEFERRED )
+	{
+		++varSyncApplied;
+		return 0;
+	}
+
+	if ( varSyncPending == NULL )
+	{
+		varSyncPending = g_hash_table_new ( g_direct_hash, g_direct_equal );
+	}
+
+	if ( g_hash_table_lookup ( varSyncPending, data ) != NULL )
+	{
+		++varSyncSkipped;
+		return 1;
+	}
+
+	write = g_new ( VarSyncWrite, 1 );
+	write->obj = obj;
+	write->proc = proc;
+	write->data = data;
+	write->interp = interp;
+	write->variable = g_strdup ( variable );
+
+	g_object_weak_ref ( obj, varSyncObjGone, write );
+	g_hash_table_insert ( varSyncPending, data, write );
+
+	if ( varSyncSource == 0 )
+	{
+		varSyncSource = g_idle_add_full ( GDK_PRIORITY_REDRAW - 1, varSyncApply, NULL, NULL );
+	}
+
+	return 1;
+}
+
+/**
+\brief     Drop a pending write, the trace with this data is being removed.
+\date      2026-10
+**/
+void gnoclVarSyncCancel ( ClientData data )
+{
+	VarSyncWrite *write;
+
+	if ( varSyncPending == NULL || ( write = g_hash_table_lookup ( varSyncPending, data ) ) == NULL )
+	{
+		return;
+	}
+
+	g_object_weak_unref ( write->obj, varSyncObjGone, write );
+	g_hash_table_remove ( varSyncPending, data );
+	varSyncWriteFree ( write );
+}
+
 /**
 \brief  Provides tracer function on variables
  */
@@ -398,6 +658,7 @@ int gnoclAttacheOptCmdAndVar ( GnoclOption *newCmd, char **oldCmd, GnoclOption *
 		if ( *oldVar )
 		{
 			Tcl_UntraceVar ( interp, *oldVar, TCL_TRACE_WRITES | TCL_GLOBAL_ONLY, tclFunc, data );
+			gnoclVarSyncCancel ( data );
 			g_free ( *oldVar );
 			*oldVar = NULL;
 		}
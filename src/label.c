@@ -128,6 +128,7 @@ static GnoclOption labelOptions[] =
 	{ "-angle", GNOCL_DOUBLE, "angle" },
 
 	{ "-tooltip", GNOCL_OBJ, "", gnoclOptTooltip },
+	{ "-variableSync", GNOCL_OBJ, "", gnoclOptVariableSync },
 
 	{ NULL }
 };
@@ -213,7 +214,12 @@ static char *traceFunc (
 
 	if ( para->inSetVar == 0 && name1 )
 	{
-		const char *txt = name1 ? Tcl_GetVar2 ( interp, name1, name2, 0 ) : NULL;
+		const char *txt;
+
+		if ( gnoclVarSyncDefer ( G_OBJECT ( para->label ), traceFunc, data, interp, para->textVariable ) )
+			return NULL;
+
+		txt = Tcl_GetVar2 ( interp, name1, name2, 0 );
 
 		if ( txt )
 		{
@@ -1038,6 +1038,14 @@ static int getRGBA ( Tcl_Interp *interp, Tcl_Obj *obj, int *r, int *g, int *b, i
 	return TCL_OK;
 }
 
+/**
+\brief      Parse a colour with optional alpha, the channels range from 0 to 65535.
+**/
+int gnoclGetRGBA ( Tcl_Interp *interp, Tcl_Obj *obj, int *r, int *g, int *b, int *a )
+{
+	return getRGBA ( interp, obj, r, g, b, a );
+}
+
 /**
 \brief Take colour values from a string format and assign them to location
         addressed by pointer *color.
@@ -1981,6 +1989,47 @@ int gnoclOptData ( Tcl_Interp *interp, GnoclOption *opt, GObject *obj, Tcl_Obj *
 }
 
 
+/**
+\brief      -variableSync immediate|deferred, read by gnoclVarSyncDefer
+\date       2026-10
+**/
+int gnoclOptVariableSync ( Tcl_Interp *interp, GnoclOption *opt, GObject *obj, Tcl_Obj **ret )
+{
+	const char *dataID = "gnocl::variableSync";
+
+	assert ( opt->type == GNOCL_OBJ );
+
+	if ( ret == NULL ) /* set value */
+	{
+		enum GnoclVarSync mode = GNOCL_VARSYNC_DEFAULT;
+
+		if ( *Tcl_GetString ( opt->val.obj ) != '\0'
+				&& gnoclGetVarSync ( interp, opt->val.obj, &mode ) != TCL_OK )
+		{
+			return TCL_ERROR;
+		}
+
+		g_object_set_data ( obj, dataID, GINT_TO_POINTER ( mode ) );
+	}
+
+	else /* get value */
+	{
+		switch ( GPOINTER_TO_INT ( g_object_get_data ( obj, dataID ) ) )
+		{
+			case GNOCL_VARSYNC_IMMEDIATE:
+				*ret = Tcl_NewStringObj ( "immediate", -1 );
+				break;
+			case GNOCL_VARSYNC_DEFERRED:
+				*ret = Tcl_NewStringObj ( "deferred", -1 );
+				break;
+			default:
+				*ret = Tcl_NewStringObj ( "", 0 );
+		}
+	}
+
+	return TCL_OK;
+}
+
 /**
 \brief
 \author     William J Giddings
@@ -2108,6 +2157,12 @@ static gboolean doOnExpose ( GtkWidget *widget, GdkEvent *event, gpointer data )
 		{ 0 }
 	};
 
+	/*  drawingArea -cacheSurface 1, the script only runs for dirty areas */
+	if ( gnoclExposeFromCache ( widget, ( GdkEventExpose * ) event ) )
+	{
+		return FALSE;
+	}
+
 	ps[0].val.str = gnoclGetNameFromWidget ( widget );
 	ps[1].val.str = gtk_widget_get_name ( widget );
 
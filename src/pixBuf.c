@@ -100,9 +100,27 @@ static const int fIdx  = 5;
 
 void gnoclGetPixBufList ( GList **list )
 {
+	if ( name2pixbufList == NULL )
+	{
+		return;
+	}
+
 	g_hash_table_foreach ( name2pixbufList, hash_to_list, list );
 }
 
+/**
+\brief      Call func with the id and pixbuf of every registered pixbuf.
+**/
+void gnoclForeachPixBuf ( GHFunc func, gpointer data )
+{
+	if ( name2pixbufList == NULL )
+	{
+		return;
+	}
+
+	g_hash_table_foreach ( name2pixbufList, func, data );
+}
+
 /**
 \brief  Rotate a pixbuf through an arbitrary angle (degrees).
 \author
@@ -1303,7 +1321,7 @@ int pixBufFunc ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const
 				width = gdk_pixbuf_get_width ( pixbuf );
 				height = gdk_pixbuf_get_height ( pixbuf );
 
-				widget = gnoclGetWidgetFromName ( Tcl_GetString ( objv[2] ), interp );
+				widget = gnoclGetWidgetFromObj ( interp, objv[2] );
 
 				if ( widget == NULL )
 				{
@@ -1373,7 +1391,8 @@ GdkPixbuf *gnoclGetPixBufFromName ( const char *id, Tcl_Interp *interp )
 	GdkPixbuf *pixbuf = NULL;
 	int       n;
 
-	if ( strncmp ( id, idPrefix, sizeof ( idPrefix ) - 1 ) == 0
+	if ( name2pixbufList != NULL
+			&& strncmp ( id, idPrefix, sizeof ( idPrefix ) - 1 ) == 0
 			&& ( n = atoi ( id + sizeof ( idPrefix ) - 1 ) ) > 0 )
 	{
 		pixbuf = g_hash_table_lookup ( name2pixbufList, GINT_TO_POINTER ( n ) );
@@ -1450,6 +1469,13 @@ int gnoclMemNameAndPixBuf ( const char *path,  GdkPixbuf *pixbuf )
 
 	n = atoi ( path + sizeof ( idPrefix ) - 1 );
 
+	/* pixbufs can be registered before gnocl::pixBuf ever ran,
+	   e.g. by gnocl::snapshot -pixBuf or gnocl::clipboard getImage */
+	if ( name2pixbufList == NULL )
+	{
+		name2pixbufList = g_hash_table_new ( g_direct_hash, g_direct_equal );
+	}
+
 	assert ( n > 0 );
 	assert ( g_hash_table_lookup ( name2pixbufList, GINT_TO_POINTER ( n ) ) == NULL );
 	assert ( strncmp ( path, idPrefix, sizeof ( idPrefix ) - 1 ) == 0 );
@@ -1690,7 +1716,7 @@ int gnoclPixBufCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * co
 							*/
 
 							GtkWidget *widget;
-							widget = gnoclGetWidgetFromName ( Tcl_GetString ( objv[3] ), interp  );
+							widget = gnoclGetWidgetFromObj ( interp, objv[3] );
 
 							if ( widget == NULL )
 							{
@@ -3,6 +3,7 @@
 \author     William J Giddings
 \date       22/05/09
 \notes      Only a prototype implementation.
+            2026-10 file printing streams the file and can export to PDF.
 
 How does it work:
     print text buffer to object...
@@ -35,9 +36,13 @@ typedef struct
 	gchar *filename;
 	gdouble font_size;
 	gint lines_per_page;
-	gchar **lines;
 	gint total_lines;
 	gint total_pages;
+	GIOChannel *channel;        /* the file, read again page by page */
+	GArray *offsets;            /* byte offset of the first line of each page */
+	GString *line;              /* reused line buffer */
+	PangoLayout *layout;        /* shared by all pages */
+	GError *error;              /* set if begin_print could not open the file */
 } PrintData;
 
 /* user data */
@@ -52,14 +57,26 @@ typedef struct
 GtkPrintSettings *settings;
 
 
-static void printFile ( gchar *filename, Widgets* );
+static int printFile ( Tcl_Interp*, gchar *filename, const char *exportName, gdouble fontSize, Widgets* );
 
 static void print_file ( GtkButton*, Widgets* );
 static void begin_print ( GtkPrintOperation*, GtkPrintContext*, Widgets* );
 static void draw_page ( GtkPrintOperation*, GtkPrintContext*, gint, Widgets* );
 static void end_print ( GtkPrintOperation*, GtkPrintContext*, Widgets* );
 
+static const int exportIdx = 0;
+static const int fontSizeIdx = 1;
+
+static GnoclOption printFileOptions[] =
+{
+	{ "-export", GNOCL_STRING, NULL },
+	{ "-fontSize", GNOCL_DOUBLE, NULL },
+	{ NULL }
+};
+
 /**
+\note      2026-10 "file path ?-export out.pdf? ?-fontSize points?" prints without
+           the chooser window, and with -export without any dialog at all.
 **/
 int gnoclPrintCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
 {
@@ -69,14 +86,17 @@ int gnoclPrintCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * con
 
 	/* objc is not consistent, move into the switch block below */
 
+	if ( objc < 2 )
+	{
+		Tcl_WrongNumArgs ( interp, 1, objv, "option ?arg ...?" );
+		return TCL_ERROR;
+	}
 
 	if ( Tcl_GetIndexFromObj ( interp, objv[1], cmd, "print", TCL_EXACT, &idx ) != TCL_OK )
 	{
 		return TCL_ERROR;
 	}
 
-	g_print ( "objc = %d opt = %s  id = %s\n", objc, Tcl_GetString ( objv[1] ), Tcl_GetString ( objv[2] ) );
-
 	switch ( idx )
 	{
 		case WidgetIdx:
@@ -93,12 +113,33 @@ int gnoclPrintCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * con
 			break;
 		case FileIdx:
 			{
-				g_print ( "Print File\n" );
-
-				if ( objc <= 1 )
+				if ( objc >= 3 )
 				{
-					Tcl_WrongNumArgs ( interp, 1, objv, "option widgetid " );
-					return TCL_ERROR;
+					Widgets w = { NULL, NULL, NULL };
+					const char *exportName = NULL;
+					gdouble fontSize = 10.0;
+					int ret;
+
+					if ( gnoclParseOptions ( interp, objc - 2, objv + 2, printFileOptions ) != TCL_OK )
+					{
+						gnoclClearOptions ( printFileOptions );
+						return TCL_ERROR;
+					}
+
+					if ( printFileOptions[exportIdx].status == GNOCL_STATUS_CHANGED )
+					{
+						exportName = printFileOptions[exportIdx].val.str;
+					}
+
+					if ( printFileOptions[fontSizeIdx].status == GNOCL_STATUS_CHANGED )
+					{
+						fontSize = printFileOptions[fontSizeIdx].val.d;
+					}
+
+					ret = printFile ( interp, Tcl_GetString ( objv[2] ), exportName, fontSize, &w );
+					gnoclClearOptions ( printFileOptions );
+
+					return ret;
 				}
 
 				/* code from Krause */
@@ -207,86 +248,94 @@ int gnoclPrintCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * con
 }
 
 /**
+\brief  Print a text file.
+\note   With exportName the job is written to that PDF file without any dialog.
+        Errors go to the interpreter result, or into a message dialog when
+        called from the chooser window with interp NULL.
 **/
-/* Print the selected file with a font of "Monospace 10". */
-static void printFile ( gchar *filename, Widgets *w )
+static int printFile ( Tcl_Interp *interp, gchar *filename, const char *exportName, gdouble fontSize, Widgets *w )
 {
-
-	g_print ( "printFile 1\n" );
-
 	GtkPrintOperation *operation;
+	GtkPrintOperationAction action = GTK_PRINT_OPERATION_ACTION_PRINT_DIALOG;
 	GtkWidget *dialog;
 	GError *error = NULL;
 	gint res;
-
+	int ret = TCL_OK;
 
 	/* Create a new print operation, applying saved print settings if they exist. */
 	operation = gtk_print_operation_new ();
 
-	if ( filename == NULL )
-		return;
-
-
 	if ( settings != NULL )
 	{
 		gtk_print_operation_set_print_settings ( operation, settings );
 	}
 
-	g_print ( "printFile 2\n" );
+	if ( exportName != NULL )
+	{
+		gtk_print_operation_set_export_filename ( operation, exportName );
+		action = GTK_PRINT_OPERATION_ACTION_EXPORT;
+	}
 
 	/* allocate a chunk of memory for printing data */
-	w->data = g_slice_new ( PrintData );
-
+	w->data = g_slice_new0 ( PrintData );
 	w->data->filename = g_strdup ( filename );
-
-	w->data->font_size = 10.0;
-
-	g_print ( "printFile 3\n" );
+	w->data->font_size = fontSize;
 
 	g_signal_connect ( G_OBJECT ( operation ), "begin_print", G_CALLBACK ( begin_print ), ( gpointer ) w );
-
 	g_signal_connect ( G_OBJECT ( operation ), "draw_page", G_CALLBACK ( draw_page ), ( gpointer ) w );
-
 	g_signal_connect ( G_OBJECT ( operation ), "end_print", G_CALLBACK ( end_print ), ( gpointer ) w );
 
-	g_print ( "printFile 4\n" );
-
+	res = gtk_print_operation_run ( operation, action, w->window != NULL ? GTK_WINDOW ( w->window ) : NULL, &error );
 
+	if ( error == NULL )
+	{
+		error = w->data->error;
+		w->data->error = NULL;
+	}
 
-	/* Run the default print operation that will print the selected file. */
-	res = gtk_print_operation_run ( operation, GTK_PRINT_OPERATION_ACTION_PRINT_DIALOG, GTK_WINDOW ( w->window ), &error );
-
-	g_print ( "printFile 5\n" );
+	/* Report a failed print operation. */
+	if ( error != NULL )
+	{
+		if ( interp != NULL )
+		{
+			Tcl_AppendResult ( interp, "GNOCL ERROR: ", error->message, ( char * ) NULL );
+			ret = TCL_ERROR;
+		}
+
+		else
+		{
+			dialog = gtk_message_dialog_new ( GTK_WINDOW ( w->window ),
+											  GTK_DIALOG_DESTROY_WITH_PARENT,
+											  GTK_MESSAGE_ERROR, GTK_BUTTONS_CLOSE,
+											  "%s", error->message );
+			gtk_dialog_run ( GTK_DIALOG ( dialog ) );
+			gtk_widget_destroy ( dialog );
+		}
 
-	/* If the print operation was accepted, save the new print settings. */
+		g_error_free ( error );
+	}
 
-	if ( res == GTK_PRINT_OPERATION_RESULT_APPLY )
+	/* If the print dialog was accepted, save the new print settings. */
+	else if ( res == GTK_PRINT_OPERATION_RESULT_APPLY && exportName == NULL )
 	{
 		if ( settings != NULL )
+		{
 			g_object_unref ( settings );
+		}
 
 		settings = g_object_ref ( gtk_print_operation_get_print_settings ( operation ) );
 	}
 
-	/* Otherwise, report that the print operation has failed. */
-
-	else if ( error )
-	{
-		dialog = gtk_message_dialog_new ( GTK_WINDOW ( w->window ),
-										  GTK_DIALOG_DESTROY_WITH_PARENT,
-										  GTK_MESSAGE_ERROR, GTK_BUTTONS_CLOSE,
-										  error->message );
-
-		g_error_free ( error );
-		gtk_dialog_run ( GTK_DIALOG ( dialog ) );
-		gtk_widget_destroy ( dialog );
-	}
+	/* begin_print may have stopped before end_print was due */
+	end_print ( operation, NULL, w );
 
-	g_print ( "printFile 6\n" );
+	g_free ( w->data->filename );
+	g_slice_free ( PrintData, w->data );
+	w->data = NULL;
 
 	g_object_unref ( operation );
 
-
+	return ret;
 }
 
 
@@ -299,11 +348,7 @@ static void printFile ( gchar *filename, Widgets *w )
 /* Print the selected file with a font of "Monospace 10". */
 static void print_file ( GtkButton *button, Widgets *w )
 {
-	GtkPrintOperation *operation;
-	GtkWidget *dialog;
-	GError *error = NULL;
 	gchar *filename;
-	gint res;
 
 	/* Return if a file has not been selected because there is nothing to print. */
 	filename = gtk_file_chooser_get_filename ( GTK_FILE_CHOOSER ( w->chooser ) );
@@ -311,51 +356,7 @@ static void print_file ( GtkButton *button, Widgets *w )
 	if ( filename == NULL )
 		return;
 
-	/* Create a new print operation, applying saved print settings if they exist. */
-	operation = gtk_print_operation_new ();
-
-	if ( settings != NULL )
-		gtk_print_operation_set_print_settings ( operation, settings );
-
-	w->data = g_slice_new ( PrintData );
-
-	w->data->filename = g_strdup ( filename );
-
-	w->data->font_size = 10.0;
-
-	g_signal_connect ( G_OBJECT ( operation ), "begin_print", G_CALLBACK ( begin_print ), ( gpointer ) w );
-
-	g_signal_connect ( G_OBJECT ( operation ), "draw_page", G_CALLBACK ( draw_page ), ( gpointer ) w );
-
-	g_signal_connect ( G_OBJECT ( operation ), "end_print", G_CALLBACK ( end_print ), ( gpointer ) w );
-
-	/* Run the default print operation that will print the selected file. */
-	res = gtk_print_operation_run ( operation, GTK_PRINT_OPERATION_ACTION_PRINT_DIALOG, GTK_WINDOW ( w->window ), &error );
-
-	/* If the print operation was accepted, save the new print settings. */
-	if ( res == GTK_PRINT_OPERATION_RESULT_APPLY )
-	{
-		if ( settings != NULL )
-			g_object_unref ( settings );
-
-		settings = g_object_ref ( gtk_print_operation_get_print_settings ( operation ) );
-	}
-
-	/* Otherwise, report that the print operation has failed. */
-
-	else if ( error )
-	{
-		dialog = gtk_message_dialog_new ( GTK_WINDOW ( w->window ),
-										  GTK_DIALOG_DESTROY_WITH_PARENT,
-										  GTK_MESSAGE_ERROR, GTK_BUTTONS_CLOSE,
-										  error->message );
-
-		g_error_free ( error );
-		gtk_dialog_run ( GTK_DIALOG ( dialog ) );
-		gtk_widget_destroy ( dialog );
-	}
-
-	g_object_unref ( operation );
+	printFile ( NULL, filename, NULL, 10.0, w );
 
 	g_free ( filename );
 }
@@ -363,35 +364,63 @@ static void print_file ( GtkButton *button, Widgets *w )
 
 /**
 **/
-/* Begin the printing by retrieving the contents of the selected files and
- * spliting it into single lines of text. */
+/* Begin the printing by scanning the file once for the offset at which each
+ * page starts. Only the current line is held in memory, pages are read back
+ * in draw_page. */
 static void begin_print ( GtkPrintOperation *operation, GtkPrintContext *context, Widgets *w )
 {
-	gchar *contents;
+	PrintData *data = w->data;
+	PangoFontDescription *desc;
 	gdouble height;
-	gsize length;
+	gint64 offset = 0;
+	gint line = 0;
 
-	/* Retrieve the file contents and split it into lines of text. */
-	g_file_get_contents ( w->data->filename, &contents, &length, NULL );
-	w->data->lines = g_strsplit ( contents, "\n", 0 );
+	data->channel = g_io_channel_new_file ( data->filename, "r", &data->error );
 
-	/* Count the total number of lines in the file. */
-	w->data->total_lines = 0;
+	if ( data->channel == NULL )
+	{
+		gtk_print_operation_cancel ( operation );
+		return;
+	}
 
-	while ( w->data->lines[w->data->total_lines] != NULL )
-		w->data->total_lines++;
+	/* raw bytes so that seeking back to a page is allowed */
+	g_io_channel_set_encoding ( data->channel, NULL, NULL );
 
 	/* Based on the height of the page and font size, calculate how many lines can be
 	 * rendered on a single page. A padding of 3 is placed between lines as well. */
 	height = gtk_print_context_get_height ( context ) - HEADER_HEIGHT - HEADER_GAP;
 
-	w->data->lines_per_page = floor ( height / ( w->data->font_size + 3 ) );
+	data->lines_per_page = MAX ( 1, floor ( height / ( data->font_size + 3 ) ) );
+
+	data->offsets = g_array_new ( FALSE, FALSE, sizeof ( gint64 ) );
+	data->line = g_string_sized_new ( 256 );
+	g_array_append_val ( data->offsets, offset );
 
-	w->data->total_pages = ( w->data->total_lines - 1 ) / w->data->lines_per_page + 1;
+	while ( g_io_channel_read_line_string ( data->channel, data->line, NULL, NULL ) == G_IO_STATUS_NORMAL )
+	{
+		offset += data->line->len;
+
+		if ( ++line % data->lines_per_page == 0 )
+		{
+			g_array_append_val ( data->offsets, offset );
+		}
+	}
+
+	data->total_lines = line;
+	data->total_pages = MAX ( 1, ( line + data->lines_per_page - 1 ) / data->lines_per_page );
 
-	gtk_print_operation_set_n_pages ( operation, w->data->total_pages );
+	/* an exact multiple of lines_per_page leaves an offset at the end of the file */
+	g_array_set_size ( data->offsets, data->total_pages );
 
-	g_free ( contents );
+	gtk_print_operation_set_n_pages ( operation, data->total_pages );
+
+	/* one layout and font for the whole job */
+	data->layout = gtk_print_context_create_pango_layout ( context );
+	desc = pango_font_description_from_string ( "Monospace" );
+	pango_font_description_set_size ( desc, data->font_size * PANGO_SCALE );
+	pango_layout_set_font_description ( data->layout, desc );
+	pango_layout_set_width ( data->layout, -1 );
+	pango_font_description_free ( desc );
 }
 
 /**
@@ -400,55 +429,63 @@ static void begin_print ( GtkPrintOperation *operation, GtkPrintContext *context
  * with one page of text with a font of "Monospace 10". */
 static void draw_page ( GtkPrintOperation *operation, GtkPrintContext *context, gint page_nr, Widgets *w )
 {
+	PrintData *data = w->data;
+	PangoLayout *layout = data->layout;
 	cairo_t *cr;
-	PangoLayout *layout;
 	gdouble width, text_height;
-	gint line, i, text_width, layout_height;
-	PangoFontDescription *desc;
+	gint i, text_width, layout_height;
 	gchar *page_str;
+	gsize term;
+	const gchar *valid;
 
 	cr = gtk_print_context_get_cairo_context ( context );
 	width = gtk_print_context_get_width ( context );
-	layout = gtk_print_context_create_pango_layout ( context );
-	desc = pango_font_description_from_string ( "Monospace" );
-	pango_font_description_set_size ( desc, w->data->font_size * PANGO_SCALE );
 
 	/* Render the page header with the filename and page number. */
-	pango_layout_set_font_description ( layout, desc );
-	pango_layout_set_text ( layout, w->data->filename, -1 );
-	pango_layout_set_width ( layout, -1 );
-	pango_layout_set_alignment ( layout, PANGO_ALIGN_LEFT );
+	pango_layout_set_text ( layout, data->filename, -1 );
 	pango_layout_get_size ( layout, NULL, &layout_height );
 	text_height = ( gdouble ) layout_height / PANGO_SCALE;
 
 	cairo_move_to ( cr, 0, ( HEADER_HEIGHT - text_height ) / 2 );
 	pango_cairo_show_layout ( cr, layout );
 
-	page_str = g_strdup_printf ( "%d of %d", page_nr + 1, w->data->total_pages );
+	page_str = g_strdup_printf ( "%d of %d", page_nr + 1, data->total_pages );
 	pango_layout_set_text ( layout, page_str, -1 );
 	pango_layout_get_size ( layout, &text_width, NULL );
-	pango_layout_set_alignment ( layout, PANGO_ALIGN_RIGHT );
 
 	cairo_move_to ( cr, width - ( text_width / PANGO_SCALE ),
 					( HEADER_HEIGHT - text_height ) / 2 );
 	pango_cairo_show_layout ( cr, layout );
 
-	/* Render the page text with the specified font and size. */
+	g_free ( page_str );
+
+	/* Render the page text, reading it from where begin_print found the page. */
 	cairo_move_to ( cr, 0, HEADER_HEIGHT + HEADER_GAP );
-	line = page_nr * w->data->lines_per_page;
 
-	for ( i = 0; i < w->data->lines_per_page && line < w->data->total_lines; i++ )
+	if ( g_io_channel_seek_position ( data->channel, g_array_index ( data->offsets, gint64, page_nr ), G_SEEK_SET, NULL ) != G_IO_STATUS_NORMAL )
 	{
-		pango_layout_set_text ( layout, w->data->lines[line], -1 );
-		pango_cairo_show_layout ( cr, layout );
-		cairo_rel_move_to ( cr, 0, w->data->font_size + 3 );
-		line++;
+		return;
 	}
 
-	g_free ( page_str );
+	for ( i = 0; i < data->lines_per_page; i++ )
+	{
+		if ( g_io_channel_read_line_string ( data->channel, data->line, &term, NULL ) != G_IO_STATUS_NORMAL )
+		{
+			break;
+		}
 
-	g_object_unref ( layout );
-	pango_font_description_free ( desc );
+		g_string_truncate ( data->line, term );
+
+		/* pango only takes UTF-8, drop anything after an invalid byte */
+		if ( !g_utf8_validate ( data->line->str, data->line->len, &valid ) )
+		{
+			g_string_truncate ( data->line, valid - data->line->str );
+		}
+
+		pango_layout_set_text ( layout, data->line->str, data->line->len );
+		pango_cairo_show_layout ( cr, layout );
+		cairo_rel_move_to ( cr, 0, data->font_size + 3 );
+	}
 }
 
 /**
@@ -456,8 +493,29 @@ static void draw_page ( GtkPrintOperation *operation, GtkPrintContext *context,
 /* Clean up after the printing operation since it is done. */
 static void end_print ( GtkPrintOperation *operation, GtkPrintContext *context, Widgets *w )
 {
-	g_strfreev ( w->data->lines );
-	g_slice_free1 ( sizeof ( PrintData ), w->data );
-	w->data = NULL;
-}
+	PrintData *data = w->data;
+
+	if ( data->layout != NULL )
+	{
+		g_object_unref ( data->layout );
+		data->layout = NULL;
+	}
+
+	if ( data->channel != NULL )
+	{
+		g_io_channel_unref ( data->channel );
+		data->channel = NULL;
+	}
+
+	if ( data->offsets != NULL )
+	{
+		g_array_free ( data->offsets, TRUE );
+		data->offsets = NULL;
+	}
 
+	if ( data->line != NULL )
+	{
+		g_string_free ( data->line, TRUE );
+		data->line = NULL;
+	}
+}
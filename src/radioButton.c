@@ -45,6 +45,7 @@
 
 /*
    History:
+   2026-10: groups index members by value and track the active member
    2008-10: added command, class
    2004-02: added -data
         09: renamed -value to -onValue
@@ -89,6 +90,7 @@ static GnoclOption radioButtonOptions[] =
 	{ "-sensitive", GNOCL_BOOL, "sensitive" },
 	{ "-tooltip", GNOCL_OBJ, "", gnoclOptTooltip },
 	{ "-visible", GNOCL_BOOL, "visible" },
+	{ "-variableSync", GNOCL_OBJ, "", gnoclOptVariableSync },
 	{ NULL },
 };
 /*****/
@@ -139,6 +141,8 @@ GnoclRadioGroup *gnoclRadioGroupNewGroup ( const char *var, Tcl_Interp *interp )
 {
 	GnoclRadioGroup *group = g_new ( GnoclRadioGroup, 1 );
 	group->widgets = g_array_new ( 0, 0, sizeof ( void * ) );
+	group->values = g_hash_table_new_full ( g_str_hash, g_str_equal, g_free, NULL );
+	group->active = NULL;
 	group->variable = g_strdup ( var );
 	group->interp = interp;
 	group->inSetVar = 0;
@@ -165,10 +169,32 @@ GnoclRadioGroup *gnoclRadioGroupNewGroup ( const char *var, Tcl_Interp *interp )
 int gnoclRadioGroupAddWidgetToGroup ( GnoclRadioGroup *group,
 									  GnoclRadioParams *para )
 {
+	gboolean on;
+
+	para->member = group->widgets->len;
 	group->widgets = g_array_append_val ( group->widgets, para );
+
+	/* the first button of a gtk radio group starts switched on */
+	g_object_get ( G_OBJECT ( para->widget ), "active", &on, NULL );
+
+	if ( on && group->active == NULL )
+		group->active = para;
+
 	return TCL_OK;
 }
 
+/**
+\brief     Drop the value index entry of a member, if it still owns it.
+\date      2026-10
+**/
+static void radioForgetValue ( GnoclRadioGroup *group, GnoclRadioParams *para )
+{
+	if ( para->onValue != NULL
+			&& g_hash_table_lookup ( group->values,
+									 Tcl_GetString ( para->onValue ) ) == para )
+		g_hash_table_remove ( group->values, Tcl_GetString ( para->onValue ) );
+}
+
 /**
 \brief
 \author Peter G Baum
@@ -184,24 +210,21 @@ int gnoclRadioSetValueActive ( GnoclRadioParams *para, GnoclOption *value,
 	{
 		/* test, if this value is already used in this group */
 		const char *val = Tcl_GetString ( value->val.obj );
-		guint k;
+		GnoclRadioParams *p = g_hash_table_lookup ( group->values, val );
 
-		for ( k = 0; k < group->widgets->len; ++k )
+		if ( p != NULL && p != para )
 		{
-			GnoclRadioParams *p = g_array_index ( group->widgets,
-												  GnoclRadioParamsPointer, k );
-
-			if ( p != para && strcmp ( Tcl_GetString ( p->onValue ), val ) == 0 )
-			{
-				Tcl_AppendResult ( group->interp, "Widget \"", p->name,
-								   "\" has same value \"", val,
-								   "\" in this radio group.", NULL );
-				return TCL_ERROR;
-			}
+			Tcl_AppendResult ( group->interp, "Widget \"", p->name,
+							   "\" has same value \"", val,
+							   "\" in this radio group.", NULL );
+			return TCL_ERROR;
 		}
 
-		/* move value to button parameter */
+		/* move value to button parameter and re-index it */
+		radioForgetValue ( group, para );
 		GNOCL_MOVE_OBJ ( value->val.obj, para->onValue );
+		g_hash_table_insert ( group->values,
+							  g_strdup ( Tcl_GetString ( para->onValue ) ), para );
 
 		/* if variable does not exist or this widget is active,
 		   create it with this onValue,
@@ -241,36 +264,38 @@ int gnoclRadioSetValueActive ( GnoclRadioParams *para, GnoclOption *value,
 int gnoclRadioRemoveWidgetFromGroup ( GnoclRadioGroup *group,
 									  GnoclRadioParams *para )
 {
-	guint k;
+	guint k = para->member;
 
-	for ( k = 0; k < group->widgets->len; ++k )
-	{
-		void *p = g_array_index ( group->widgets, gpointer, k );
+	assert ( k < group->widgets->len
+			 && g_array_index ( group->widgets, GnoclRadioParamsPointer, k ) == para );
 
-		if ( p == para )
-		{
-			g_array_remove_index_fast ( group->widgets, k );
+	radioForgetValue ( group, para );
 
-			if ( group->widgets->len == 0 )
-			{
-				/* remove complete group */
-				Tcl_UntraceVar ( group->interp, group->variable,
-								 TCL_TRACE_WRITES | TCL_GLOBAL_ONLY, gnoclRadioTraceFunc,
-								 group );
-				g_hash_table_remove ( radioGroup, group->variable );
-				g_free ( group->variable );
-				g_array_free ( group->widgets, 1 );
-				g_free ( group );
-				return 0;
-			}
+	if ( group->active == para )
+		group->active = NULL;
 
-			return group->widgets->len;
-		}
-	}
+	/* the last member takes over the freed slot */
+	g_array_remove_index_fast ( group->widgets, k );
+
+	if ( k < group->widgets->len )
+		g_array_index ( group->widgets, GnoclRadioParamsPointer, k )->member = k;
 
-	assert ( 0 );
+	if ( group->widgets->len == 0 )
+	{
+		/* remove complete group */
+		Tcl_UntraceVar ( group->interp, group->variable,
+						 TCL_TRACE_WRITES | TCL_GLOBAL_ONLY, gnoclRadioTraceFunc,
+						 group );
+		gnoclVarSyncCancel ( group );
+		g_hash_table_remove ( radioGroup, group->variable );
+		g_free ( group->variable );
+		g_hash_table_destroy ( group->values );
+		g_array_free ( group->widgets, 1 );
+		g_free ( group );
+		return 0;
+	}
 
-	return -1;
+	return group->widgets->len;
 }
 
 /**
@@ -281,31 +306,7 @@ int gnoclRadioRemoveWidgetFromGroup ( GnoclRadioGroup *group,
 **/
 GnoclRadioParams *gnoclRadioGetActivePara ( GnoclRadioGroup *group )
 {
-	guint k;
-
-	/*
-	for( k = 0; k < group->widgets->len; ++k )
-	{
-	   int on;
-	   GnoclRadioParams *p = g_array_index( group->widgets,
-	                     GnoclRadioParamsPointer, k );
-	   g_object_get( G_OBJECT( p->widget ), "active", &on, NULL );
-	   printf( "%d %s active: %d\n", k, p->name, on );
-	}
-	*/
-
-	for ( k = 0; k < group->widgets->len; ++k )
-	{
-		int on;
-		GnoclRadioParams *p = g_array_index ( group->widgets,
-											  GnoclRadioParamsPointer, k );
-		g_object_get ( G_OBJECT ( p->widget ), "active", &on, NULL );
-
-		if ( on )
-			return p;
-	}
-
-	return NULL;
+	return group->active;
 }
 
 /**
@@ -357,38 +358,55 @@ static int radioSetVariable ( GnoclRadioParams *para, Tcl_Obj *value )
 	return TCL_OK;
 }
 
+/**
+\brief     Switch a single member without running its -onToggled script.
+\date      2026-10
+**/
+static void radioSetActive ( GnoclRadioParams *para, gboolean on )
+{
+	int blocked = g_signal_handlers_block_matched (
+					  G_OBJECT ( para->widget ), G_SIGNAL_MATCH_FUNC,
+					  0, 0, NULL, ( gpointer * ) gnoclRadioToggledFunc, NULL );
+	g_object_set ( G_OBJECT ( para->widget ), "active", on, NULL );
+
+	if ( blocked )
+		g_signal_handlers_unblock_matched (
+			G_OBJECT ( para->widget ), G_SIGNAL_MATCH_FUNC,
+			0, 0, NULL, ( gpointer * ) gnoclRadioToggledFunc, NULL );
+}
+
 /**
 \brief
 \author Peter G Baum
 \date
-\note
+\note      2026-10: only the previously and the newly active member are
+            touched; the value is looked up in the group index.
 **/
 static int radioSetState ( GnoclRadioGroup *group, Tcl_Obj *obj )
 {
-	const char *val = Tcl_GetString ( obj );
-	guint k;
-	int set = 0;
+	GnoclRadioParams *para = g_hash_table_lookup ( group->values,
+							 Tcl_GetString ( obj ) );
+	GnoclRadioParams *old = group->active;
 
-	for ( k = 0; k < group->widgets->len; ++k )
+	if ( old != NULL && old != para )
 	{
-		GnoclRadioParams *para = g_array_index ( group->widgets,
-								 GnoclRadioParamsPointer, k );
-		int on = ( strcmp ( Tcl_GetString ( para->onValue ), val ) == 0 );
-		int blocked = g_signal_handlers_block_matched (
-						  G_OBJECT ( para->widget ), G_SIGNAL_MATCH_FUNC,
-						  0, 0, NULL, ( gpointer * ) gnoclRadioToggledFunc, NULL );
-		g_object_set ( G_OBJECT ( para->widget ), "active", ( gboolean ) on, NULL );
-		set += on;
-
-		if ( blocked )
-			g_signal_handlers_unblock_matched (
-				G_OBJECT ( para->widget ), G_SIGNAL_MATCH_FUNC,
-				0, 0, NULL, ( gpointer * ) gnoclRadioToggledFunc, NULL );
+		gboolean on;
+
+		radioSetActive ( old, 0 );
+
+		/* gtk keeps the only active button of a group switched on */
+		g_object_get ( G_OBJECT ( old->widget ), "active", &on, NULL );
+		group->active = on ? old : NULL;
 	}
 
-	assert ( set <= 1 );
+	if ( para != NULL )
+	{
+		radioSetActive ( para, 1 );
+		group->active = para;
+		return 1;
+	}
 
-	return set;
+	return 0;
 }
 
 /**
@@ -453,9 +471,13 @@ void gnoclRadioToggledFunc ( GtkWidget *widget, gpointer data )
 
 	if ( on )
 	{
+		para->group->active = para;
 		radioSetVariable ( para, para->onValue );
 		radioDoCommand ( para, 1 );
 	}
+
+	else if ( para->group->active == para )
+		para->group->active = NULL;
 }
 
 /**
@@ -471,7 +493,15 @@ char *gnoclRadioTraceFunc ( ClientData data,
 
 	if ( group->inSetVar == 0 )
 	{
-		Tcl_Obj *val = Tcl_GetVar2Ex ( interp, name1, name2, flags );
+		Tcl_Obj *val;
+
+		/* the group follows the mode of its first member */
+		if ( group->widgets->len > 0
+				&& gnoclVarSyncDefer ( G_OBJECT ( gnoclRadioGetParam ( group, 0 )->widget ),
+									   gnoclRadioTraceFunc, data, interp, group->variable ) )
+			return NULL;
+
+		val = Tcl_GetVar2Ex ( interp, name1, name2, flags );
 
 		if ( val )
 			radioSetState ( group, val );
@@ -97,6 +97,7 @@ GnoclOption scaleOptions[] =
 	{ "-updatePolicy", GNOCL_OBJ, "update-policy", optUpdatePolicy },
 	{ "-valuePos", GNOCL_OBJ, "value-pos", gnoclOptPosition },
 	{ "-visible", GNOCL_BOOL, "visible" },
+	{ "-variableSync", GNOCL_OBJ, "", gnoclOptVariableSync },
 	{ NULL }
 };
 /*****/
@@ -237,9 +238,14 @@ static char *traceFunc ( ClientData data,
 
 	if ( para->inSetVar == 0 && name1 != NULL )
 	{
-		Tcl_Obj *val = Tcl_GetVar2Ex ( interp, name1, name2, flags );
+		Tcl_Obj *val;
 		double d;
 
+		if ( gnoclVarSyncDefer ( G_OBJECT ( para->scale ), traceFunc, data, interp, para->variable ) )
+			return NULL;
+
+		val = Tcl_GetVar2Ex ( interp, name1, name2, flags );
+
 		if ( val && Tcl_GetDoubleFromObj ( NULL, val, &d ) == TCL_OK )
 		{
 			setValue ( para->scale, d );
@@ -95,6 +95,7 @@ static GnoclOption spinButtonOptions[] =
 	{ "-visible", GNOCL_BOOL, "visible" },
 	{ "-widthGroup", GNOCL_OBJ, "w", gnoclOptSizeGroup },
 	{ "-wrap", GNOCL_BOOL,  "wrap" },
+	{ "-variableSync", GNOCL_OBJ, "", gnoclOptVariableSync },
 	{ NULL }
 };
 /*****/
@@ -203,7 +204,12 @@ static char *traceFunc ( ClientData data,
 
 	if ( para->inSetVar == 0 && name1 != NULL )
 	{
-		Tcl_Obj *val = Tcl_GetVar2Ex ( interp, name1, name2, flags );
+		Tcl_Obj *val;
+
+		if ( gnoclVarSyncDefer ( G_OBJECT ( para->spinButton ), traceFunc, data, interp, para->variable ) )
+			return NULL;
+
+		val = Tcl_GetVar2Ex ( interp, name1, name2, flags );
 
 		if ( val )
 		{
@@ -94,6 +94,11 @@
 *  entry, label, GtkTextBuffer, GtkTextView
 *
 *  MODIFICATION HISTORY
+*   2026-10     added -tagTable to share a named tag table between buffers
+*   2026-10     added tag applyRanges|removeRanges
+*   2026-10     added highlight set|refresh|clear, incremental syntax highlighting
+*   2026-10     completed dump all|windows|images|marks, added dump toggles
+*   2026-10     added getIndices, getRanges; parsed indices cached with their Tcl_Obj
                 added lorem - insert some dummy text for preview purposes
 *   2010-03     added getIndex, return line / char info at location x y in textview
 *   2010-01     added -buffer
@@ -250,6 +255,7 @@
 #include "gnocl.h"
 
 #include <string.h>
+#include <stdlib.h>
 #include <assert.h>
 
 
@@ -479,6 +485,64 @@ static int _gnoclOptBackgroundImage (
 
 }
 
+/*  named tag tables, the entries do not hold a reference */
+static GHashTable *name2tagTable = NULL;
+
+/**
+\brief      Drop the name of a tag table once its last buffer is gone.
+**/
+static void tagTableFinalized ( gpointer data, GObject *table )
+{
+	g_hash_table_remove ( name2tagTable, data );
+	g_free ( data );
+}
+
+/**
+\brief      Return a new reference to the tag table called name.
+\date       2026-10
+\note       The table is created on first use and lives as long as a buffer
+            uses it, so tags created through one buffer are shared by all.
+**/
+GtkTextTagTable *gnoclGetTagTable ( const char *name )
+{
+	GtkTextTagTable *table;
+
+	if ( name2tagTable == NULL )
+	{
+		name2tagTable = g_hash_table_new ( g_str_hash, g_str_equal );
+	}
+
+	table = g_hash_table_lookup ( name2tagTable, name );
+
+	if ( table != NULL )
+	{
+		return g_object_ref ( table );
+	}
+
+	table = gtk_text_tag_table_new ();
+	name = g_strdup ( name );
+	g_hash_table_insert ( name2tagTable, ( gpointer ) name, table );
+	g_object_weak_ref ( G_OBJECT ( table ), tagTableFinalized, ( gpointer ) name );
+
+	return table;
+}
+
+/**
+\brief      The tag table of a buffer is fixed on construction, so -tagTable
+            can only be configured to the table already in use.
+**/
+int gnoclCheckTagTable ( Tcl_Interp *interp, GtkTextBuffer *buffer, const char *name )
+{
+	if ( name2tagTable == NULL
+			|| g_hash_table_lookup ( name2tagTable, name ) != gtk_text_buffer_get_tag_table ( buffer ) )
+	{
+		Tcl_SetResult ( interp, "-tagTable can only be set on creation", TCL_STATIC );
+		return TCL_ERROR;
+	}
+
+	return TCL_OK;
+}
+
 /**
 \brief
     Description yet to be added.
@@ -489,6 +553,7 @@ static int _gnoclOptBackgroundImage (
 static const int scrollBarIdx = 0;
 static const int textIdx = 1;
 static const int bufferIdx = 2;
+static const int tagTableIdx = 3;
 
 static GnoclOption textOptions[] =
 {
@@ -498,6 +563,7 @@ static GnoclOption textOptions[] =
 	{ "-scrollbar", GNOCL_OBJ, NULL },
 	{ "-text", GNOCL_STRING, NULL},
 	{ "-buffer", GNOCL_STRING, NULL},
+	{ "-tagTable", GNOCL_STRING, NULL},
 
 	/* GtkTextView properties
 	"accepts-tab"              gboolean              : Read / Write
@@ -664,34 +730,111 @@ static GnoclOption textOptions[] =
 
 
 /**
-\brief      Convert at text index in the form of {row col} into a GtkTextBuffer iter(ator).
-\author     Peter G Baum
-\date       2001-06:
-\bug        (text_cursor_keyWords_test.tcl:13461): Gtk-WARNING **: Invalid text buffer iterator: either the iterator is uninitialized,
-            or the characters/pixbufs/widgets in the buffer have been modified since the iterator was created.
-            You must use marks, character numbers, or line numbers to preserve a position across buffer modifications.
-            You can apply tags and insert marks without invalidating your iterators,
-            but any mutation that affects 'indexable' buffer contents (contents that can be referred to by character offset)
-            will invalidate all outstanding iterators
-            Causes: moving the inter does not act on the buffer, once the iter has been moved, then it n
-\todo       Include new keywords
-                sentenceStart
-                sentenceEnd
-                paragraphStart
-                paragraphEnd
-                wordStart
-                wordEnd
-                lineEnd
-\history
-    2008-06-27  Began implementation of new keywords for text position. See TODO.
-*/
-int posToIter ( Tcl_Interp *interp, Tcl_Obj *obj, GtkTextBuffer *buffer, GtkTextIter *iter )
+\brief      Parsed form of a text index, kept as the internal representation
+            of the Tcl_Obj that carried it so that each index string is
+            parsed only once.
+\note       The keywords are resolved against the buffer on each call, only
+            the parsing is cached.
+**/
+typedef enum
+{
+	TEXT_INDEX_ROWCOL,
+	TEXT_INDEX_OFFSET,
+	TEXT_INDEX_START,
+	TEXT_INDEX_END,
+	TEXT_INDEX_CURSOR,
+	TEXT_INDEX_SELECTIONSTART,
+	TEXT_INDEX_SELECTIONEND,
+	TEXT_INDEX_WORDSTART,
+	TEXT_INDEX_WORDEND,
+	TEXT_INDEX_SENTENCESTART,
+	TEXT_INDEX_SENTENCEEND,
+	TEXT_INDEX_LINESTART,
+	TEXT_INDEX_LINEEND
+} TextIndexType;
+
+typedef struct
+{
+	TextIndexType type;
+	int           row;
+	int           col;
+	int           rowIsEnd;
+	int           colIsEnd;
+	int           offset;       /* character offset or keyword offset */
+} TextIndex;
+
+static void freeTextIndexIntRep ( Tcl_Obj *obj );
+static void dupTextIndexIntRep ( Tcl_Obj *src, Tcl_Obj *dup );
+
+static Tcl_ObjType textIndexType =
+{
+	"gnoclTextIndex",
+	freeTextIndexIntRep,
+	dupTextIndexIntRep,
+	NULL,               /* the string representation is never invalidated */
+	NULL
+};
+
+/* index keywords, matched as prefix, the remainder is the offset */
+static const struct
+{
+	const char    *name;
+	int           len;
+	TextIndexType type;
+} textIndexKeywords[] =
+{
+	{ "start", 5, TEXT_INDEX_START },
+	{ "end", 3, TEXT_INDEX_END },
+	{ "cursor", 6, TEXT_INDEX_CURSOR },
+	{ "selectionStart", 14, TEXT_INDEX_SELECTIONSTART },
+	{ "selectionEnd", 12, TEXT_INDEX_SELECTIONEND },
+	{ "wordStart", 9, TEXT_INDEX_WORDSTART },
+	{ "wordEnd", 7, TEXT_INDEX_WORDEND },
+	{ "sentenceStart", 13, TEXT_INDEX_SENTENCESTART },
+	{ "sentenceEnd", 11, TEXT_INDEX_SENTENCEEND },
+	{ "lineStart", 9, TEXT_INDEX_LINESTART },
+	{ "lineEnd", 7, TEXT_INDEX_LINEEND },
+	{ NULL }
+};
+
+/**
+**/
+static void freeTextIndexIntRep ( Tcl_Obj *obj )
+{
+	ckfree ( ( char * ) obj->internalRep.otherValuePtr );
+	obj->internalRep.otherValuePtr = NULL;
+}
+
+/**
+**/
+static void dupTextIndexIntRep ( Tcl_Obj *src, Tcl_Obj *dup )
+{
+	TextIndex *idx = ( TextIndex * ) ckalloc ( sizeof ( TextIndex ) );
+
+	*idx = * ( TextIndex * ) src->internalRep.otherValuePtr;
+	dup->internalRep.otherValuePtr = idx;
+	dup->typePtr = &textIndexType;
+}
+
+/**
+\brief      Parse a text index into its cached form, see posToIter for the syntax.
+\author     Peter G Baum, William J Giddings
+\note       The Tcl_Obj is only converted if parsing succeeds.
+**/
+static int getTextIndexFromObj ( Tcl_Interp *interp, Tcl_Obj *obj, TextIndex **pidx )
 {
 	char errMsg[] = "Position must be either a list of row and column "
 					"or a keyword plus offset";
 	char errEndOffset[] = "offset to \"end\" must be negative";
 
-	int len;
+	TextIndex index;
+	int       len;
+
+	if ( obj->typePtr == &textIndexType )
+	{
+		*pidx = ( TextIndex * ) obj->internalRep.otherValuePtr;
+		return TCL_OK;
+	}
 
 	/*  error check the arguments passed to the function */
 
@@ -701,7 +844,7 @@ int posToIter ( Tcl_Interp *interp, Tcl_Obj *obj, GtkTextBuffer *buffer, GtkText
 		return TCL_ERROR;
 	}
 
-	/*  this is right */
+	memset ( &index, 0, sizeof ( index ) );
 
 	if ( len == 2 )
 	{
@@ -739,32 +882,17 @@ int posToIter ( Tcl_Interp *interp, Tcl_Obj *obj, GtkTextBuffer *buffer, GtkText
 
 				else
 				{
-					Tcl_AppendResult ( interp, "unknown row or column index \"", txt, "\" must be integer or end plus offset" );
+					Tcl_AppendResult ( interp, "unknown row or column index \"", txt, "\" must be integer or end plus offset", NULL );
 					return TCL_ERROR;
 				}
-
 			}
 		}
 
-		gtk_text_buffer_get_start_iter ( buffer, iter );
-
-		if ( isEnd[0] )
-		{
-			gtk_text_iter_set_line ( iter, -1 );
-			gtk_text_iter_backward_lines ( iter, -idx[0] );
-		}
-
-		else
-			gtk_text_iter_set_line ( iter, idx[0] );
-
-		if ( isEnd[0] )
-		{
-			gtk_text_iter_forward_to_line_end ( iter );
-			gtk_text_iter_backward_chars ( iter, -idx[1] );
-		}
-
-		else
-			gtk_text_iter_forward_chars ( iter, idx[1] );
+		index.type = TEXT_INDEX_ROWCOL;
+		index.row = idx[0];
+		index.col = idx[1];
+		index.rowIsEnd = isEnd[0];
+		index.colIsEnd = isEnd[1];
 	}
 
 	else if ( Tcl_GetIntFromObj ( NULL, obj, &len ) == TCL_OK )
@@ -775,344 +903,1306 @@ int posToIter ( Tcl_Interp *interp, Tcl_Obj *obj, GtkTextBuffer *buffer, GtkText
 			return TCL_ERROR;
 		}
 
-		gtk_text_buffer_get_iter_at_offset ( buffer, iter, len );
+		index.type = TEXT_INDEX_OFFSET;
+		index.offset = len;
 	}
 
 	else
 	{
 		const char *txt = Tcl_GetString ( obj );
-		const char *last;
-		int offset;
-
-		/*  get a fresh iterator, it may have already been altered due to a previous call */
-		gtk_text_buffer_get_iter_at_mark ( buffer, iter, gtk_text_buffer_get_insert ( buffer ) );
-
+		int k;
 
-		if ( strncmp ( txt, "start", 5 ) == 0 )
+		for ( k = 0; textIndexKeywords[k].name != NULL; ++k )
 		{
-			//printf ( "checking start\n" );
-			gtk_text_buffer_get_start_iter ( buffer, iter );
-			last = txt + 5;
+			if ( strncmp ( txt, textIndexKeywords[k].name, textIndexKeywords[k].len ) == 0 )
+			{
+				break;
+			}
 		}
 
-		else if ( strncmp ( txt, "end", 3 ) == 0 )
+		if ( textIndexKeywords[k].name == NULL )
 		{
-			//printf ( "checking end\n" );
-			gtk_text_buffer_get_end_iter ( buffer, iter );
-			last = txt + 3;
+			Tcl_AppendResult ( interp, "unknown index \"", txt,
+							   "\", must be a list of row and column, "
+							   "an integer as character offset, "
+							   "or one of start, end, cursor, wordStart, wordEnd, sentenceStart, sentenceEnd, lineStart, lineEnd, selectionStart, or selectionEnd",
+							   NULL );
+			return TCL_ERROR;
 		}
 
-		else if ( strncmp ( txt, "cursor", 6 ) == 0 )
-		{
-			last = txt + 6;
-			gtk_text_buffer_get_iter_at_mark ( buffer, iter, gtk_text_buffer_get_insert ( buffer ) );
-		}
+		if ( gnoclPosOffset ( interp, txt + textIndexKeywords[k].len, &index.offset ) != TCL_OK )
+			return TCL_ERROR;
+
+		index.type = textIndexKeywords[k].type;
+	}
+
+	/*  make sure the string representation survives before replacing the old internal one */
+	Tcl_GetString ( obj );
+
+	if ( obj->typePtr != NULL && obj->typePtr->freeIntRepProc != NULL )
+	{
+		obj->typePtr->freeIntRepProc ( obj );
+	}
+
+	*pidx = ( TextIndex * ) ckalloc ( sizeof ( TextIndex ) );
+	**pidx = index;
+	obj->internalRep.otherValuePtr = *pidx;
+	obj->typePtr = &textIndexType;
+
+	return TCL_OK;
+}
+
+/**
+\brief      Character offsets of line starts, kept with each buffer.
+\note       Only the first starts->len lines are known. An edit at line n
+            cannot move the start of lines 0..n, so the cache is only
+            truncated there and extended again on demand.
+**/
+typedef struct
+{
+	GArray *starts;
+} TextLineCache;
+
+/**
+**/
+static void lineCacheTruncate ( TextLineCache *cache, GtkTextIter *iter )
+{
+	guint keep = gtk_text_iter_get_line ( iter ) + 1;
+
+	if ( cache->starts->len > keep )
+	{
+		g_array_set_size ( cache->starts, keep );
+	}
+}
+
+/**
+**/
+static void lineCacheOnInsertText ( GtkTextBuffer *buffer, GtkTextIter *location, gchar *text, gint len, gpointer data )
+{
+	lineCacheTruncate ( ( TextLineCache * ) data, location );
+}
+
+/**
+\note       Used for "delete-range", "insert-pixbuf" and "insert-child-anchor".
+**/
+static void lineCacheOnEdit ( GtkTextBuffer *buffer, GtkTextIter *iter, gpointer arg, gpointer data )
+{
+	lineCacheTruncate ( ( TextLineCache * ) data, iter );
+}
+
+/**
+**/
+static void lineCacheFree ( gpointer data )
+{
+	TextLineCache *cache = ( TextLineCache * ) data;
+
+	g_array_free ( cache->starts, 1 );
+	g_free ( cache );
+}
+
+/**
+\brief      Return the character offset at which line starts.
+\note       line must be a valid line number of the buffer.
+**/
+static gint getLineStart ( GtkTextBuffer *buffer, gint line )
+{
+	TextLineCache *cache = g_object_get_data ( G_OBJECT ( buffer ), "gnocl::lineCache" );
+	GtkTextIter iter;
+
+	if ( cache == NULL )
+	{
+		gint zero = 0;
+
+		cache = g_new ( TextLineCache, 1 );
+		cache->starts = g_array_new ( 0, 0, sizeof ( gint ) );
+		g_array_append_val ( cache->starts, zero );
+
+		/*  connect before the default handlers, these still see the unchanged buffer */
+		g_signal_connect ( G_OBJECT ( buffer ), "insert-text", G_CALLBACK ( lineCacheOnInsertText ), cache );
+		g_signal_connect ( G_OBJECT ( buffer ), "delete-range", G_CALLBACK ( lineCacheOnEdit ), cache );
+		g_signal_connect ( G_OBJECT ( buffer ), "insert-pixbuf", G_CALLBACK ( lineCacheOnEdit ), cache );
+		g_signal_connect ( G_OBJECT ( buffer ), "insert-child-anchor", G_CALLBACK ( lineCacheOnEdit ), cache );
+
+		g_object_set_data_full ( G_OBJECT ( buffer ), "gnocl::lineCache", cache, lineCacheFree );
+	}
+
+	if ( line < cache->starts->len )
+	{
+		return g_array_index ( cache->starts, gint, line );
+	}
+
+	gtk_text_buffer_get_iter_at_offset ( buffer, &iter, g_array_index ( cache->starts, gint, cache->starts->len - 1 ) );
+
+	while ( cache->starts->len <= line && gtk_text_iter_forward_line ( &iter ) )
+	{
+		gint offset = gtk_text_iter_get_offset ( &iter );
+		g_array_append_val ( cache->starts, offset );
+	}
+
+	return g_array_index ( cache->starts, gint, cache->starts->len - 1 );
+}
+
+/**
+\brief      Convert at text index in the form of {row col} into a GtkTextBuffer iter(ator).
+\author     Peter G Baum
+\date       2001-06:
+\bug        (text_cursor_keyWords_test.tcl:13461): Gtk-WARNING **: Invalid text buffer iterator: either the iterator is uninitialized,
+            or the characters/pixbufs/widgets in the buffer have been modified since the iterator was created.
+            You must use marks, character numbers, or line numbers to preserve a position across buffer modifications.
+            You can apply tags and insert marks without invalidating your iterators,
+            but any mutation that affects 'indexable' buffer contents (contents that can be referred to by character offset)
+            will invalidate all outstanding iterators
+            Causes: moving the inter does not act on the buffer, once the iter has been moved, then it n
+\todo       Include new keywords
+                paragraphStart
+                paragraphEnd
+\history
+    2008-06-27  Began implementation of new keywords for text position. See TODO.
+    2026-10     Parsed indices are cached in the Tcl_Obj, {row col} resolved via the line start cache.
+*/
+int posToIter ( Tcl_Interp *interp, Tcl_Obj *obj, GtkTextBuffer *buffer, GtkTextIter *iter )
+{
+	TextIndex *index;
+
+	if ( getTextIndexFromObj ( interp, obj, &index ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	switch ( index->type )
+	{
+		case TEXT_INDEX_ROWCOL:
+			{
+				gint lastLine = gtk_text_buffer_get_line_count ( buffer ) - 1;
+				gint line = index->rowIsEnd ? lastLine + index->row : index->row;
+
+				if ( line < 0 )
+				{
+					line = 0;
+				}
+
+				else if ( line > lastLine )
+				{
+					line = lastLine;
+				}
+
+				if ( index->colIsEnd )
+				{
+					gtk_text_buffer_get_iter_at_offset ( buffer, iter, getLineStart ( buffer, line ) );
+
+					if ( !gtk_text_iter_ends_line ( iter ) )
+					{
+						gtk_text_iter_forward_to_line_end ( iter );
+					}
+
+					gtk_text_iter_backward_chars ( iter, -index->col );
+				}
+
+				else
+				{
+					/*  like forward_chars, a column beyond the line end moves on into the next lines */
+					gtk_text_buffer_get_iter_at_offset ( buffer, iter, getLineStart ( buffer, line ) + index->col );
+				}
+			}
+
+			return TCL_OK;
+		case TEXT_INDEX_OFFSET:
+			{
+				gtk_text_buffer_get_iter_at_offset ( buffer, iter, index->offset );
+			}
+
+			return TCL_OK;
+		case TEXT_INDEX_START:
+			{
+				gtk_text_buffer_get_start_iter ( buffer, iter );
+			}
+
+			break;
+		case TEXT_INDEX_END:
+			{
+				gtk_text_buffer_get_end_iter ( buffer, iter );
+			}
+
+			break;
+		case TEXT_INDEX_SELECTIONSTART:
+			{
+				GtkTextIter end;
+				gtk_text_buffer_get_selection_bounds ( buffer, iter, &end );
+			}
+
+			break;
+		case TEXT_INDEX_SELECTIONEND:
+			{
+				GtkTextIter start;
+				gtk_text_buffer_get_selection_bounds ( buffer, &start, iter );
+			}
+
+			break;
+		default:
+			{
+				/*  the remaining keywords are relative to the cursor */
+				gtk_text_buffer_get_iter_at_mark ( buffer, iter, gtk_text_buffer_get_insert ( buffer ) );
+
+				switch ( index->type )
+				{
+					case TEXT_INDEX_WORDSTART:
+						gtk_text_iter_backward_word_start ( iter );
+						break;
+					case TEXT_INDEX_WORDEND:
+						gtk_text_iter_forward_word_end ( iter );
+						break;
+					case TEXT_INDEX_SENTENCESTART:
+						gtk_text_iter_backward_sentence_start ( iter );
+						break;
+					case TEXT_INDEX_SENTENCEEND:
+						gtk_text_iter_forward_sentence_end ( iter );
+						break;
+					case TEXT_INDEX_LINESTART:
+						gtk_text_iter_set_line_offset ( iter, 0 );
+						break;
+					case TEXT_INDEX_LINEEND:
+
+						if ( !gtk_text_iter_ends_line ( iter ) )
+						{
+							gtk_text_iter_forward_to_line_end ( iter );
+						}
+
+						break;
+					default:
+						break;
+				}
+			}
+	}
+
+	if ( index->offset > 0 )
+		gtk_text_iter_forward_chars ( iter, index->offset );
+	else if ( index->offset < 0 )
+		gtk_text_iter_backward_chars ( iter, -index->offset );
+
+	return TCL_OK;
+}
+
+/**
+\brief      Resolve a list of positions in one call.
+\note       Returns a list of {row col} pairs, one for each position.
+**/
+static int getIndices ( GtkTextBuffer *buffer, Tcl_Interp *interp, Tcl_Obj *list )
+{
+	Tcl_Obj **elems;
+	Tcl_Obj **res;
+	int     k, no;
+	int     ret = TCL_ERROR;
+
+	if ( Tcl_ListObjGetElements ( interp, list, &no, &elems ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	res = ( Tcl_Obj ** ) ckalloc ( sizeof ( Tcl_Obj * ) * ( no + 1 ) );
+
+	for ( k = 0; k < no; ++k )
+	{
+		GtkTextIter iter;
+		Tcl_Obj *pair[2];
+
+		if ( posToIter ( interp, elems[k], buffer, &iter ) != TCL_OK )
+		{
+			int i;
+
+			for ( i = 0; i < k; ++i )
+			{
+				Tcl_DecrRefCount ( res[i] );
+			}
+
+			goto clearExit;
+		}
+
+		pair[0] = Tcl_NewIntObj ( gtk_text_iter_get_line ( &iter ) );
+		pair[1] = Tcl_NewIntObj ( gtk_text_iter_get_line_offset ( &iter ) );
+		res[k] = Tcl_NewListObj ( 2, pair );
+		Tcl_IncrRefCount ( res[k] );
+	}
+
+	Tcl_SetObjResult ( interp, Tcl_NewListObj ( no, res ) );
+
+	for ( k = 0; k < no; ++k )
+	{
+		Tcl_DecrRefCount ( res[k] );
+	}
+
+	ret = TCL_OK;
+
+clearExit:
+	ckfree ( ( char * ) res );
+
+	return ret;
+}
+
+/**
+\brief      Return the text of a list of ranges {start end start end ...} in one call.
+**/
+static int getRanges ( GtkTextBuffer *buffer, Tcl_Interp *interp, Tcl_Obj *list )
+{
+	Tcl_Obj **elems;
+	Tcl_Obj *resList;
+	int     k, no;
+
+	if ( Tcl_ListObjGetElements ( interp, list, &no, &elems ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( no % 2 )
+	{
+		Tcl_SetResult ( interp, "range list must contain pairs of start and end index", TCL_STATIC );
+		return TCL_ERROR;
+	}
+
+	resList = Tcl_NewListObj ( 0, NULL );
+
+	for ( k = 0; k < no; k += 2 )
+	{
+		GtkTextIter start, end;
+		char *txt;
+
+		if ( posToIter ( interp, elems[k], buffer, &start ) != TCL_OK
+				|| posToIter ( interp, elems[k+1], buffer, &end ) != TCL_OK )
+		{
+			Tcl_DecrRefCount ( resList );
+			return TCL_ERROR;
+		}
+
+		/*  TODO: include_hidden_chars */
+		txt = gtk_text_buffer_get_text ( buffer, &start, &end, 1 );
+		Tcl_ListObjAppendElement ( NULL, resList, Tcl_NewStringObj ( txt, -1 ) );
+		g_free ( txt );
+	}
+
+	Tcl_SetObjResult ( interp, resList );
+
+	return TCL_OK;
+}
+
+/**
+\brief      Compare two {start end} offset pairs by their start.
+**/
+static int compareRanges ( const void *a, const void *b )
+{
+	return ( ( const gint * ) a ) [0] - ( ( const gint * ) b ) [0];
+}
+
+/**
+\brief      Apply or remove a tag over a list of character offset ranges.
+\date       2026-10
+\note       <widgetid> tag applyRanges tagName {start end start end ...}
+            <widgetid> tag removeRanges tagName {start end start end ...}
+            The ranges are sorted and overlapping ones merged, then the buffer
+            is walked once with a single moving iterator. The whole batch is
+            one user action.
+**/
+static int tagRanges ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc, Tcl_Obj *  const objv[], int cmdNo, int apply )
+{
+	GtkTextTag  *tag;
+	GtkTextIter start, end;
+	Tcl_Obj     **elems;
+	gint        *ranges;
+	gint        k, no, len, pos;
+
+	if ( objc != cmdNo + 2 )
+	{
+		Tcl_WrongNumArgs ( interp, cmdNo, objv, "tagName {start end ...}" );
+		return TCL_ERROR;
+	}
+
+	tag = gtk_text_tag_table_lookup ( gtk_text_buffer_get_tag_table ( buffer ), Tcl_GetString ( objv[cmdNo] ) );
+
+	if ( tag == NULL )
+	{
+		Tcl_AppendResult ( interp, "Unknown tag \"", Tcl_GetString ( objv[cmdNo] ), "\"", NULL );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_ListObjGetElements ( interp, objv[cmdNo+1], &no, &elems ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	if ( no % 2 )
+	{
+		Tcl_SetResult ( interp, "range list must contain pairs of start and end offsets", TCL_STATIC );
+		return TCL_ERROR;
+	}
+
+	if ( no == 0 )
+	{
+		return TCL_OK;
+	}
+
+	ranges = g_new ( gint, no );
+	len = gtk_text_buffer_get_char_count ( buffer );
+
+	for ( k = 0; k < no; k += 2 )
+	{
+		if ( Tcl_GetIntFromObj ( interp, elems[k], ranges + k ) != TCL_OK
+				|| Tcl_GetIntFromObj ( interp, elems[k+1], ranges + k + 1 ) != TCL_OK )
+		{
+			g_free ( ranges );
+			return TCL_ERROR;
+		}
+
+		ranges[k] = CLAMP ( ranges[k], 0, len );
+		ranges[k+1] = CLAMP ( ranges[k+1], 0, len );
+
+		if ( ranges[k] > ranges[k+1] )
+		{
+			gint tmp = ranges[k];
+			ranges[k] = ranges[k+1];
+			ranges[k+1] = tmp;
+		}
+	}
+
+	qsort ( ranges, no / 2, 2 * sizeof ( gint ), compareRanges );
+
+	gtk_text_buffer_begin_user_action ( buffer );
+	gtk_text_buffer_get_start_iter ( buffer, &start );
+	pos = 0;
+
+	for ( k = 0; k < no; )
+	{
+		gint from = ranges[k];
+		gint to = ranges[k+1];
+
+		/*  merge the following overlapping or adjacent ranges */
+		for ( k += 2; k < no && ranges[k] <= to; k += 2 )
+		{
+			to = MAX ( to, ranges[k+1] );
+		}
+
+		if ( from == to )
+		{
+			continue;
+		}
+
+		gtk_text_iter_forward_chars ( &start, from - pos );
+		end = start;
+		gtk_text_iter_forward_chars ( &end, to - from );
+
+		if ( apply )
+		{
+			gtk_text_buffer_apply_tag ( buffer, tag, &start, &end );
+		}
+
+		else
+		{
+			gtk_text_buffer_remove_tag ( buffer, tag, &start, &end );
+		}
+
+		/*  changing tags does not invalidate iterators */
+		start = end;
+		pos = to;
+	}
+
+	gtk_text_buffer_end_user_action ( buffer );
+	g_free ( ranges );
+
+	return TCL_OK;
+}
+
+/**
+\brief      Apply a lists of tags to the a specified range of text.
+\author     William J Giddings
+\date       Nov-2007
+\note       Derived from textInsert.
+**/
+static int applyTag ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc, Tcl_Obj *  const objv[], int cmdNo )
+{
+	/**
+	Or, does it appear here?
+	*/
+	/*  declare some variables */
+	// console error messaging
+	GnoclOption insertOptions[] =
+	{
+		{ "-tags", GNOCL_LIST, NULL },
+		{ NULL }
+	};
+	const int tagsIdx = 0;
+	gint      startOffset;
+	gint   endOffset;
+	int       ret = TCL_ERROR;
+
+	GtkTextIter   iter;
+	GtkTextIter   iter2;
+
+	/*  The arguments passed in the tcl script are in the objv array. These are:
+	0:  {0 0}       fromIndex
+	+1:     {0 end}   toIndex
+	+2:       -tags
+	+3:     bold cursor     taglist
+	*/
+
+	/*
+	printf ( "-2: {%s} \n-1: {%s} \n0: {%s} \n+1: {%s} \n+2: %s \n+3: %s \n",
+	 gnoclGetString ( objv[cmdNo-2] ),
+	 gnoclGetString ( objv[cmdNo-1] ),
+	 gnoclGetString ( objv[cmdNo] ),
+	 gnoclGetString ( objv[cmdNo+1] ),
+	 gnoclGetString ( objv[cmdNo+2] ),
+	 gnoclGetString ( objv[cmdNo+3] ) );
+	*/
+
+	// "position text ?-option val ...?"
+
+	if ( objc < cmdNo + 2 )
+	{
+		Tcl_WrongNumArgs ( interp, cmdNo, objv, "fromIndex toIndex -tags {tag1 tag2...}S" );
+		return TCL_ERROR;
+	}
+
+	/*  determine some value */
+	// get position of fromIndex within the buffer as in iterator
+
+	if ( posToIter ( interp, objv[cmdNo], buffer, &iter ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	// get position of toIndex within the buffer as in iterator
+
+	if ( posToIter ( interp, objv[cmdNo+1], buffer, &iter2 ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	/*  parse options, check to see if they are suitable */
+
+	if ( gnoclParseOptions ( interp, objc - cmdNo - 1, objv + cmdNo + 1, insertOptions ) != TCL_OK )
+	{
+		goto clearExit;
+	}
+
+	startOffset = gtk_text_iter_get_offset ( &iter );
+
+	endOffset = gtk_text_iter_get_offset ( &iter2 );
+
+	/*  add the tags, gets a list and then works through them */
+
+	if ( insertOptions[tagsIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		GtkTextIter start;
+		GtkTextIter end;
+		int k, no;
+		Tcl_Obj *obj = insertOptions[tagsIdx].val.obj;
+
+		/*  get the offset position for the inserted text*/
+		gtk_text_buffer_get_iter_at_offset ( buffer, &start, startOffset );
+		gtk_text_buffer_get_iter_at_offset ( buffer, &end, endOffset );
+
+		if ( Tcl_ListObjLength ( interp, obj, &no ) != TCL_OK )
+		{
+			goto clearExit;
+		}
+
+		/*  apply each tag in turn */
+
+		for ( k = 0; k < no; ++k )
+		{
+			Tcl_Obj *tp;
+
+			if ( Tcl_ListObjIndex ( interp, obj, k, &tp ) != TCL_OK )
+			{
+				Tcl_SetResult ( interp, "Could not read tag list", TCL_STATIC );
+				goto clearExit;
+			}
+
+			gtk_text_buffer_apply_tag_by_name ( buffer, Tcl_GetString ( tp ), &start, &end );
+
+		}
+	}
+
+	ret = TCL_OK;
+
+clearExit:
+	gnoclClearOptions ( insertOptions );
+
+	return ret;
+}
+
+/**
+\brief
+\author     William J Giddings
+\date       Nov/2007
+\note
+**/
+static int removeTag ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc, Tcl_Obj *  const objv[], int cmdNo )
+{
+	/*  declare some variables */
+	// console error messaging
+	GnoclOption insertOptions[] =
+	{
+		{ "-tags", GNOCL_LIST, NULL },
+		{ NULL }
+	};
+	const int tagsIdx = 0;
+	gint      startOffset;
+	gint   endOffset;
+	int       ret = TCL_ERROR;
+
+	GtkTextIter   iter;
+	GtkTextIter   iter2;
+
+	/*  The arguments passed in the tcl script are in the objv array. These are:
+	0:  {0 0}       fromIndex
+	+1:     {0 end}   toIndex
+	+2:       -tags
+	+3:     bold cursor     taglist
+	*/
+	/*
+	printf ( "-2: {%s} \n-1: {%s} \n0: {%s} \n+1: {%s} \n+2: %s \n+3: %s \n",
+	 gnoclGetString ( objv[cmdNo-2] ),
+	 gnoclGetString ( objv[cmdNo-1] ),
+	 gnoclGetString ( objv[cmdNo] ),
+	 gnoclGetString ( objv[cmdNo+1] ),
+	 gnoclGetString ( objv[cmdNo+2] ),
+	 gnoclGetString ( objv[cmdNo+3] ) );
+	*/
+	// "position text ?-option val ...?"
+
+	if ( objc < cmdNo + 2 )
+	{
+		Tcl_WrongNumArgs ( interp, cmdNo, objv, "fromIndex toIndex -tags {tag1 tag2...}S" );
+		return TCL_ERROR;
+	}
+
+	/*  determine some value */
+	// get position of fromIndex within the buffer as in iterator
+
+	if ( posToIter ( interp, objv[cmdNo], buffer, &iter ) != TCL_OK ) return TCL_ERROR;
+
+	// get position of toIndex within the buffer as in iterator
+	if ( posToIter ( interp, objv[cmdNo+1], buffer, &iter2 ) != TCL_OK ) return TCL_ERROR;
+
+	/*  parse options, check to see if they are suitable */
+	if ( gnoclParseOptions ( interp, objc - cmdNo - 1, objv + cmdNo + 1, insertOptions ) != TCL_OK ) goto clearExit;
+
+	startOffset = gtk_text_iter_get_offset ( &iter );
+
+	endOffset = gtk_text_iter_get_offset ( &iter2 );
+
+	/*  add the tags, gets a list and then works through them */
+	if ( insertOptions[tagsIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		GtkTextIter start;
+		GtkTextIter end;
+		int k, no;
+		Tcl_Obj *obj = insertOptions[tagsIdx].val.obj;
+
+		/*  get the offset position for the inserted text*/
+		gtk_text_buffer_get_iter_at_offset ( buffer, &start, startOffset );
+		gtk_text_buffer_get_iter_at_offset ( buffer, &end, endOffset );
+
+		if ( Tcl_ListObjLength ( interp, obj, &no ) != TCL_OK ) goto clearExit;
+
+		/*  apply each tag in turn */
+		for ( k = 0; k < no; ++k )
+		{
+			Tcl_Obj *tp;
+
+			if ( Tcl_ListObjIndex ( interp, obj, k, &tp ) != TCL_OK )
+			{
+				Tcl_SetResult ( interp, "Could not read tag list", TCL_STATIC );
+				goto clearExit;
+			}
+
+			gtk_text_buffer_remove_tag_by_name ( buffer, Tcl_GetString ( tp ), &start, &end );
+
+		}
+	}
+
+	ret = TCL_OK;
+
+clearExit:
+	gnoclClearOptions ( insertOptions );
+
+	return ret;
+}
+
+/**
+\brief      Incremental syntax highlighting of a GtkTextBuffer.
+\note       A rule is either {pattern tagName} for matches within a line, or
+            {startPattern endPattern tagName} for regions which may span
+            several lines. For each line the highlighter remembers the region
+            open at its end. After an edit only the changed lines are
+            re-highlighted, and the following lines only as long as their
+            carried-over state differs, in an idle source with a time budget.
+            The result are ordinary tags, created before with "tag create".
+**/
+typedef struct
+{
+	GRegex     *pattern;        /* pattern, or start of the region */
+	GRegex     *end;            /* end of the region, NULL for single line rules */
+	GtkTextTag *tag;
+} HighlightRule;
+
+typedef struct
+{
+	GtkTextBuffer *buffer;
+	HighlightRule *rules;
+	int           noRules;
+	GArray        *lineStates;  /* rule index + 1 of the region open at the end of each line */
+	gint          lineCount;    /* line count of the buffer at the last edit */
+	gint          dirtyStart;   /* first line to re-highlight, -1 if nothing is pending */
+	gint          dirtyEnd;     /* last line which has to be re-highlighted in any case */
+	double        budget;       /* seconds per idle slice */
+	guint         idleId;
+} TextHighlight;
+
+/**
+**/
+static void highlightFree ( gpointer data )
+{
+	TextHighlight *hl = ( TextHighlight * ) data;
+	int k;
+
+	if ( hl->idleId )
+	{
+		g_source_remove ( hl->idleId );
+	}
+
+	g_signal_handlers_disconnect_matched ( G_OBJECT ( hl->buffer ), G_SIGNAL_MATCH_DATA, 0, 0, NULL, NULL, hl );
+
+	for ( k = 0; k < hl->noRules; ++k )
+	{
+		g_regex_unref ( hl->rules[k].pattern );
+
+		if ( hl->rules[k].end != NULL )
+		{
+			g_regex_unref ( hl->rules[k].end );
+		}
+
+		g_object_unref ( hl->rules[k].tag );
+	}
+
+	g_free ( hl->rules );
+	g_array_free ( hl->lineStates, 1 );
+	g_free ( hl );
+}
+
+/**
+\brief      Remove the highlight tags of the lines first..last and set them
+            to the region state 0.
+**/
+static void highlightClearLines ( TextHighlight *hl, gint first, gint last )
+{
+	GtkTextIter start, end;
+	int k;
+
+	gtk_text_buffer_get_iter_at_line ( hl->buffer, &start, first );
+	gtk_text_buffer_get_iter_at_line ( hl->buffer, &end, last );
+	gtk_text_iter_forward_line ( &end );
+
+	for ( k = 0; k < hl->noRules; ++k )
+	{
+		gtk_text_buffer_remove_tag ( hl->buffer, hl->rules[k].tag, &start, &end );
+	}
+}
+
+/**
+\brief      Apply tag to the byte range from..to of line, to < 0 means
+            up to the start of the next line.
+**/
+static void highlightApply ( TextHighlight *hl, GtkTextTag *tag, gint line, gint from, gint to )
+{
+	GtkTextIter start, end;
+
+	gtk_text_buffer_get_iter_at_line_index ( hl->buffer, &start, line, from );
+
+	if ( to < 0 )
+	{
+		gtk_text_buffer_get_iter_at_line ( hl->buffer, &end, line );
+		gtk_text_iter_forward_line ( &end );
+	}
+
+	else
+	{
+		gtk_text_buffer_get_iter_at_line_index ( hl->buffer, &end, line, to );
+	}
+
+	if ( gtk_text_iter_compare ( &start, &end ) < 0 )
+	{
+		gtk_text_buffer_apply_tag ( hl->buffer, tag, &start, &end );
+	}
+}
+
+/**
+\brief      Highlight one line, starting in region state, and return the
+            state at the end of the line.
+\note       The next match of each rule is cached and only searched for
+            again once the scan has passed it.
+**/
+static int highlightLine ( TextHighlight *hl, gint line, int state )
+{
+	GtkTextIter start, end;
+	gchar       *text;
+	gint        len, pos = 0;
+	gint        *matchStart, *matchEnd;
+	int         k;
+
+	highlightClearLines ( hl, line, line );
+
+	gtk_text_buffer_get_iter_at_line ( hl->buffer, &start, line );
+	end = start;
+
+	if ( !gtk_text_iter_ends_line ( &end ) )
+	{
+		gtk_text_iter_forward_to_line_end ( &end );
+	}
+
+	/*  the slice keeps the byte offsets of pixbufs and child anchors */
+	text = gtk_text_iter_get_slice ( &start, &end );
+	len = strlen ( text );
+
+	matchStart = g_new ( gint, 2 * hl->noRules );
+	matchEnd = matchStart + hl->noRules;
+
+	for ( k = 0; k < hl->noRules; ++k )
+	{
+		matchStart[k] = -2;
+	}
+
+	for ( ;; )
+	{
+		GMatchInfo *info;
+		int        best = -1;
+
+		if ( state != 0 )
+		{
+			HighlightRule *rule = hl->rules + state - 1;
+
+			/*  inside a region, look for its end */
+			if ( g_regex_match_full ( rule->end, text, len, pos, 0, &info, NULL ) )
+			{
+				gint s, e;
+				g_match_info_fetch_pos ( info, 0, &s, &e );
+				g_match_info_free ( info );
+				highlightApply ( hl, rule->tag, line, pos, e );
+				pos = e;
+				state = 0;
+				continue;
+			}
+
+			g_match_info_free ( info );
+			highlightApply ( hl, rule->tag, line, pos, -1 );
+			break;
+		}
+
+		for ( k = 0; k < hl->noRules; ++k )
+		{
+			if ( matchStart[k] == -2 || ( matchStart[k] >= 0 && matchStart[k] < pos ) )
+			{
+				matchStart[k] = -1;
+
+				if ( g_regex_match_full ( hl->rules[k].pattern, text, len, pos, 0, &info, NULL ) )
+				{
+					g_match_info_fetch_pos ( info, 0, matchStart + k, matchEnd + k );
+				}
+
+				g_match_info_free ( info );
+			}
+
+			if ( matchStart[k] >= 0 && ( best < 0 || matchStart[k] < matchStart[best] ) )
+			{
+				best = k;
+			}
+		}
+
+		if ( best < 0 )
+		{
+			break;
+		}
+
+		/*  a region tag starts with its start pattern */
+		highlightApply ( hl, hl->rules[best].tag, line, matchStart[best], matchEnd[best] );
+
+		if ( hl->rules[best].end != NULL )
+		{
+			state = best + 1;
+		}
+
+		if ( matchEnd[best] > matchStart[best] )
+		{
+			pos = matchEnd[best];
+		}
+
+		else if ( matchStart[best] < len )
+		{
+			/*  empty match, step over one character */
+			pos = g_utf8_next_char ( text + matchStart[best] ) - text;
+		}
+
+		else
+		{
+			/*  empty match at the end of the line */
+			if ( state != 0 )
+			{
+				highlightApply ( hl, hl->rules[best].tag, line, len, -1 );
+			}
+
+			break;
+		}
+
+		matchStart[best] = -2;
+	}
+
+	g_free ( matchStart );
+	g_free ( text );
+
+	return state;
+}
+
+/**
+\brief      Idle handler, works through the pending lines until the budget is spent.
+**/
+static gboolean highlightIdle ( gpointer data )
+{
+	TextHighlight *hl = ( TextHighlight * ) data;
+	GTimer        *timer = g_timer_new();
+	gint          lineCount = gtk_text_buffer_get_line_count ( hl->buffer );
+	gint          line = hl->dirtyStart;
+
+	while ( line >= 0 && line < lineCount )
+	{
+		int in = line == 0 ? 0 : g_array_index ( hl->lineStates, int, line - 1 );
+		int out = highlightLine ( hl, line, in );
+		int old = g_array_index ( hl->lineStates, int, line );
+
+		g_array_index ( hl->lineStates, int, line ) = out;
+		++line;
+
+		/*  behind the edit, stop as soon as the carried-over state is unchanged */
+		if ( line > hl->dirtyEnd && out == old )
+		{
+			line = -1;
+			break;
+		}
+
+		if ( g_timer_elapsed ( timer, NULL ) > hl->budget )
+		{
+			break;
+		}
+	}
+
+	g_timer_destroy ( timer );
+
+	if ( line < 0 || line >= lineCount )
+	{
+		hl->dirtyStart = -1;
+		hl->idleId = 0;
+		return 0;
+	}
+
+	hl->dirtyStart = line;
+
+	return 1;
+}
+
+/**
+**/
+static void highlightSchedule ( TextHighlight *hl, gint first, gint last )
+{
+	if ( hl->dirtyStart < 0 )
+	{
+		hl->dirtyStart = first;
+		hl->dirtyEnd = last;
+	}
+
+	else
+	{
+		hl->dirtyStart = MIN ( first, hl->dirtyStart );
+		hl->dirtyEnd = MAX ( last, hl->dirtyEnd );
+	}
+
+	if ( hl->idleId == 0 )
+	{
+		hl->idleId = g_idle_add_full ( G_PRIORITY_DEFAULT_IDLE, highlightIdle, hl, NULL );
+	}
+}
 
-		else if ( strncmp ( txt, "selectionStart", 14 ) == 0 )
-		{
-			GtkTextIter end;
-			gtk_text_buffer_get_selection_bounds ( buffer, iter, &end );
-			last = txt + 14;
-		}
+/**
+\brief      Keep the line states in step with the buffer, connected after the default handler.
+**/
+static void highlightOnInsertText ( GtkTextBuffer *buffer, GtkTextIter *location, gchar *text, gint len, gpointer data )
+{
+	TextHighlight *hl = ( TextHighlight * ) data;
+	gint count = gtk_text_buffer_get_line_count ( buffer );
+	gint last = gtk_text_iter_get_line ( location );
+	gint first = last - ( count - hl->lineCount );
 
-		else if ( strncmp ( txt, "selectionEnd", 12 ) == 0 )
-		{
-			GtkTextIter start;
-			gtk_text_buffer_get_selection_bounds ( buffer, &start, iter );
-			last = txt + 12;
-		}
+	if ( count > hl->lineCount )
+	{
+		g_array_set_size ( hl->lineStates, hl->lineStates->len + count - hl->lineCount );
+		memmove ( &g_array_index ( hl->lineStates, int, last + 1 ), &g_array_index ( hl->lineStates, int, first + 1 ),
+				  ( hl->lineCount - first - 1 ) * sizeof ( int ) );
 
-		else if ( strncmp ( txt, "wordStart", 9 ) == 0 )
+		/*  a pending range behind the insertion moves down */
+		if ( hl->dirtyStart > first )
 		{
-			/*  get a fresh itersator, it may have already been altered */
-			//gtk_text_buffer_get_iter_at_mark( buffer, iter, gtk_text_buffer_get_insert( buffer ) );
-			gtk_text_iter_backward_word_start ( iter );
-			last = txt + 9;
+			hl->dirtyStart += count - hl->lineCount;
 		}
 
-		else if ( strncmp ( txt, "wordEnd", 7 ) == 0 )
+		if ( hl->dirtyStart >= 0 && hl->dirtyEnd > first )
 		{
-			/*  get a fresh itersator, it may have already been altered */
-			//gtk_text_buffer_get_iter_at_mark( buffer, iter, gtk_text_buffer_get_insert( buffer ) );
-			gtk_text_iter_forward_word_end ( iter );
-			last = txt + 7;
+			hl->dirtyEnd += count - hl->lineCount;
 		}
+	}
 
-		/*  WJG CURRENTLY WORKING HERE. Nothing happening, also text insert now kaput! */
-
-		else if ( strncmp ( txt, "sentenceStart", 13 ) == 0 )
-		{
-			/*  get a fresh itersator, it may have already been altered */
-			//gtk_text_buffer_get_iter_at_mark( buffer, iter, gtk_text_buffer_get_insert( buffer ) );
-			gtk_text_iter_backward_sentence_start ( iter );
-			last = txt + 13;
-		}
+	hl->lineCount = count;
+	highlightSchedule ( hl, first, last );
+}
 
-		else if ( strncmp ( txt, "sentenceEnd", 11 ) == 0 )
-		{
-			/*  get a fresh itersator, it may have already been altered */
-			//gtk_text_buffer_get_iter_at_mark( buffer, iter, gtk_text_buffer_get_insert( buffer ) );
-			gtk_text_iter_forward_sentence_end ( iter );
-			last = txt + 11;
-		}
+/**
+**/
+static void highlightOnDeleteRange ( GtkTextBuffer *buffer, GtkTextIter *start, GtkTextIter *end, gpointer data )
+{
+	TextHighlight *hl = ( TextHighlight * ) data;
+	gint count = gtk_text_buffer_get_line_count ( buffer );
+	gint line = gtk_text_iter_get_line ( start );
 
-		else if ( strncmp ( txt, "lineStart", 9 ) == 0 )
-		{
-			/*  move iterator to an offset of 0 */
-			/*  get a fresh itersator, it may have already been altered */
-			//gtk_text_buffer_get_iter_at_mark( buffer, iter, gtk_text_buffer_get_insert( buffer ) );
-			gtk_text_iter_forward_sentence_end ( iter );
-			last = txt + 9;
-		}
+	if ( count < hl->lineCount )
+	{
+		g_array_remove_range ( hl->lineStates, line + 1, hl->lineCount - count );
 
-		else if ( strncmp ( txt, "lineEnd", 7 ) == 0 )
+		if ( hl->dirtyStart > line )
 		{
-			/*  move iterator to the start of the next line, then move back one offset */
-			/*  get a fresh itersator, it may have already been altered */
-			//gtk_text_buffer_get_iter_at_mark( buffer, iter, gtk_text_buffer_get_insert( buffer ) );
-			gtk_text_iter_forward_sentence_end ( iter );
-			last = txt + 7;
+			hl->dirtyStart = MAX ( line, hl->dirtyStart - hl->lineCount + count );
 		}
 
-		else
+		if ( hl->dirtyStart >= 0 && hl->dirtyEnd > line )
 		{
-			Tcl_AppendResult ( interp, "unknown index \"", txt,
-							   "\", must be a list of row and column, "
-							   "an integer as character offset, "
-							   "or one of start, end, cursor, wordStart, wordEnd, sentenceStart, sentenceEnd, lineStart, lineEnd, selectionStart, or selectionEnd",
-							   NULL );
-			return TCL_ERROR;
+			hl->dirtyEnd = MAX ( line, hl->dirtyEnd - hl->lineCount + count );
 		}
-
-		if ( gnoclPosOffset ( interp, last, &offset ) != TCL_OK )
-			return TCL_ERROR;
-
-		if ( offset > 0 )
-			gtk_text_iter_forward_chars ( iter, offset );
-		else if ( offset < 0 )
-			gtk_text_iter_backward_chars ( iter, -offset );
 	}
 
-	return TCL_OK;
+	hl->lineCount = count;
+	highlightSchedule ( hl, line, line );
 }
 
 /**
-\brief      Apply a lists of tags to the a specified range of text.
-\author     William J Giddings
-\date       Nov-2007
-\note       Derived from textInsert.
+\note       Used for "insert-pixbuf" and "insert-child-anchor".
 **/
-static int applyTag ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc, Tcl_Obj *  const objv[], int cmdNo )
+static void highlightOnInsertObject ( GtkTextBuffer *buffer, GtkTextIter *iter, gpointer arg, gpointer data )
 {
-	/**
-	Or, does it appear here?
-	*/
-	/*  declare some variables */
-	// console error messaging
-	GnoclOption insertOptions[] =
-	{
-		{ "-tags", GNOCL_LIST, NULL },
-		{ NULL }
-	};
-	const int tagsIdx = 0;
-	gint      startOffset;
-	gint   endOffset;
-	int       ret = TCL_ERROR;
-
-	GtkTextIter   iter;
-	GtkTextIter   iter2;
-
-	/*  The arguments passed in the tcl script are in the objv array. These are:
-	0:  {0 0}       fromIndex
-	+1:     {0 end}   toIndex
-	+2:       -tags
-	+3:     bold cursor     taglist
-	*/
-
-	/*
-	printf ( "-2: {%s} \n-1: {%s} \n0: {%s} \n+1: {%s} \n+2: %s \n+3: %s \n",
-	 gnoclGetString ( objv[cmdNo-2] ),
-	 gnoclGetString ( objv[cmdNo-1] ),
-	 gnoclGetString ( objv[cmdNo] ),
-	 gnoclGetString ( objv[cmdNo+1] ),
-	 gnoclGetString ( objv[cmdNo+2] ),
-	 gnoclGetString ( objv[cmdNo+3] ) );
-	*/
-
-	// "position text ?-option val ...?"
+	TextHighlight *hl = ( TextHighlight * ) data;
+	gint line = gtk_text_iter_get_line ( iter );
 
-	if ( objc < cmdNo + 2 )
-	{
-		Tcl_WrongNumArgs ( interp, cmdNo, objv, "fromIndex toIndex -tags {tag1 tag2...}S" );
-		return TCL_ERROR;
-	}
+	highlightSchedule ( hl, line, line );
+}
 
-	/*  determine some value */
-	// get position of fromIndex within the buffer as in iterator
+/**
+\brief      Compile a rule list, on error the partially filled rules are freed.
+**/
+static int highlightGetRules ( Tcl_Interp *interp, GtkTextBuffer *buffer, Tcl_Obj *list, HighlightRule **prules, int *pno )
+{
+	GtkTextTagTable *table = gtk_text_buffer_get_tag_table ( buffer );
+	HighlightRule *rules;
+	Tcl_Obj **elems;
+	int     k, no;
 
-	if ( posToIter ( interp, objv[cmdNo], buffer, &iter ) != TCL_OK )
+	if ( Tcl_ListObjGetElements ( interp, list, &no, &elems ) != TCL_OK )
 	{
 		return TCL_ERROR;
 	}
 
-	// get position of toIndex within the buffer as in iterator
+	rules = g_new0 ( HighlightRule, no );
 
-	if ( posToIter ( interp, objv[cmdNo+1], buffer, &iter2 ) != TCL_OK )
+	for ( k = 0; k < no; ++k )
 	{
-		return TCL_ERROR;
-	}
+		Tcl_Obj **parts;
+		int     n;
+		GError  *error = NULL;
 
-	/*  parse options, check to see if they are suitable */
+		if ( Tcl_ListObjGetElements ( interp, elems[k], &n, &parts ) != TCL_OK )
+		{
+			goto errorExit;
+		}
 
-	if ( gnoclParseOptions ( interp, objc - cmdNo - 1, objv + cmdNo + 1, insertOptions ) != TCL_OK )
-	{
-		goto clearExit;
-	}
+		if ( n != 2 && n != 3 )
+		{
+			Tcl_AppendResult ( interp, "rule must be {pattern tagName} or {startPattern endPattern tagName} but got \"",
+							   Tcl_GetString ( elems[k] ), "\"", NULL );
+			goto errorExit;
+		}
 
-	startOffset = gtk_text_iter_get_offset ( &iter );
+		rules[k].tag = gtk_text_tag_table_lookup ( table, Tcl_GetString ( parts[n-1] ) );
 
-	endOffset = gtk_text_iter_get_offset ( &iter2 );
+		if ( rules[k].tag == NULL )
+		{
+			Tcl_AppendResult ( interp, "Unknown tag \"", Tcl_GetString ( parts[n-1] ), "\"", NULL );
+			goto errorExit;
+		}
 
-	/*  add the tags, gets a list and then works through them */
+		g_object_ref ( rules[k].tag );
 
-	if ( insertOptions[tagsIdx].status == GNOCL_STATUS_CHANGED )
-	{
-		GtkTextIter start;
-		GtkTextIter end;
-		int k, no;
-		Tcl_Obj *obj = insertOptions[tagsIdx].val.obj;
+		rules[k].pattern = g_regex_new ( Tcl_GetString ( parts[0] ), G_REGEX_OPTIMIZE, 0, &error );
 
-		/*  get the offset position for the inserted text*/
-		gtk_text_buffer_get_iter_at_offset ( buffer, &start, startOffset );
-		gtk_text_buffer_get_iter_at_offset ( buffer, &end, endOffset );
+		if ( rules[k].pattern != NULL && n == 3 )
+		{
+			rules[k].end = g_regex_new ( Tcl_GetString ( parts[1] ), G_REGEX_OPTIMIZE, 0, &error );
+		}
 
-		if ( Tcl_ListObjLength ( interp, obj, &no ) != TCL_OK )
+		if ( error != NULL )
 		{
-			goto clearExit;
+			Tcl_AppendResult ( interp, "invalid pattern: ", error->message, NULL );
+			g_error_free ( error );
+			goto errorExit;
 		}
+	}
 
-		/*  apply each tag in turn */
+	*prules = rules;
+	*pno = no;
 
-		for ( k = 0; k < no; ++k )
-		{
-			Tcl_Obj *tp;
+	return TCL_OK;
 
-			if ( Tcl_ListObjIndex ( interp, obj, k, &tp ) != TCL_OK )
-			{
-				Tcl_SetResult ( interp, "Could not read tag list", TCL_STATIC );
-				goto clearExit;
-			}
+errorExit:
 
-			gtk_text_buffer_apply_tag_by_name ( buffer, Tcl_GetString ( tp ), &start, &end );
+	for ( k = 0; k < no; ++k )
+	{
+		if ( rules[k].pattern != NULL )
+			g_regex_unref ( rules[k].pattern );
 
-		}
-	}
+		if ( rules[k].end != NULL )
+			g_regex_unref ( rules[k].end );
 
-	ret = TCL_OK;
+		if ( rules[k].tag != NULL )
+			g_object_unref ( rules[k].tag );
+	}
 
-clearExit:
-	gnoclClearOptions ( insertOptions );
+	g_free ( rules );
 
-	return ret;
+	return TCL_ERROR;
 }
 
 /**
-\brief
-\author     William J Giddings
-\date       Nov/2007
-\note
+\brief      Attach, refresh or remove the syntax highlighter of a buffer.
+\date       2026-10
+\note       <widgetid> highlight set ruleList ?-budget ms?
+            <widgetid> highlight refresh
+            <widgetid> highlight clear
 **/
-static int removeTag ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc, Tcl_Obj *  const objv[], int cmdNo )
+static int highlightCmd ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc, Tcl_Obj *  const objv[], int cmdNo )
 {
-	/*  declare some variables */
-	// console error messaging
-	GnoclOption insertOptions[] =
-	{
-		{ "-tags", GNOCL_LIST, NULL },
-		{ NULL }
-	};
-	const int tagsIdx = 0;
-	gint      startOffset;
-	gint   endOffset;
-	int       ret = TCL_ERROR;
+	const char *cmds[] = { "set", "refresh", "clear", NULL };
+	enum cmdIdx { SetIdx, RefreshIdx, ClearIdx };
 
-	GtkTextIter   iter;
-	GtkTextIter   iter2;
+	TextHighlight *hl = g_object_get_data ( G_OBJECT ( buffer ), "gnocl::highlight" );
+	int idx;
 
-	/*  The arguments passed in the tcl script are in the objv array. These are:
-	0:  {0 0}       fromIndex
-	+1:     {0 end}   toIndex
-	+2:       -tags
-	+3:     bold cursor     taglist
-	*/
-	/*
-	printf ( "-2: {%s} \n-1: {%s} \n0: {%s} \n+1: {%s} \n+2: %s \n+3: %s \n",
-	 gnoclGetString ( objv[cmdNo-2] ),
-	 gnoclGetString ( objv[cmdNo-1] ),
-	 gnoclGetString ( objv[cmdNo] ),
-	 gnoclGetString ( objv[cmdNo+1] ),
-	 gnoclGetString ( objv[cmdNo+2] ),
-	 gnoclGetString ( objv[cmdNo+3] ) );
-	*/
-	// "position text ?-option val ...?"
+	if ( objc < cmdNo + 1 )
+	{
+		Tcl_WrongNumArgs ( interp, cmdNo, objv, "subcommand ?option val ...?" );
+		return TCL_ERROR;
+	}
 
-	if ( objc < cmdNo + 2 )
+	if ( Tcl_GetIndexFromObj ( interp, objv[cmdNo], cmds, "subcommand", TCL_EXACT, &idx ) != TCL_OK )
 	{
-		Tcl_WrongNumArgs ( interp, cmdNo, objv, "fromIndex toIndex -tags {tag1 tag2...}S" );
 		return TCL_ERROR;
 	}
 
-	/*  determine some value */
-	// get position of fromIndex within the buffer as in iterator
+	switch ( idx )
+	{
+		case SetIdx:
+			{
+				GnoclOption options[] =
+				{
+					{ "-budget", GNOCL_INT, NULL },
+					{ NULL }
+				};
+				const int budgetIdx = 0;
+				HighlightRule *rules;
+				int no;
+				double budget = 0.005;
 
-	if ( posToIter ( interp, objv[cmdNo], buffer, &iter ) != TCL_OK ) return TCL_ERROR;
+				if ( objc < cmdNo + 2 )
+				{
+					Tcl_WrongNumArgs ( interp, cmdNo + 1, objv, "ruleList ?-budget ms?" );
+					return TCL_ERROR;
+				}
 
-	// get position of toIndex within the buffer as in iterator
-	if ( posToIter ( interp, objv[cmdNo+1], buffer, &iter2 ) != TCL_OK ) return TCL_ERROR;
+				if ( gnoclParseOptions ( interp, objc - cmdNo - 1, objv + cmdNo + 1, options ) != TCL_OK )
+				{
+					gnoclClearOptions ( options );
+					return TCL_ERROR;
+				}
 
-	/*  parse options, check to see if they are suitable */
-	if ( gnoclParseOptions ( interp, objc - cmdNo - 1, objv + cmdNo + 1, insertOptions ) != TCL_OK ) goto clearExit;
+				if ( options[budgetIdx].status == GNOCL_STATUS_CHANGED )
+				{
+					if ( options[budgetIdx].val.i <= 0 )
+					{
+						Tcl_SetResult ( interp, "-budget must be greater zero", TCL_STATIC );
+						gnoclClearOptions ( options );
+						return TCL_ERROR;
+					}
 
-	startOffset = gtk_text_iter_get_offset ( &iter );
+					budget = options[budgetIdx].val.i / 1000.;
+				}
 
-	endOffset = gtk_text_iter_get_offset ( &iter2 );
+				gnoclClearOptions ( options );
 
-	/*  add the tags, gets a list and then works through them */
-	if ( insertOptions[tagsIdx].status == GNOCL_STATUS_CHANGED )
-	{
-		GtkTextIter start;
-		GtkTextIter end;
-		int k, no;
-		Tcl_Obj *obj = insertOptions[tagsIdx].val.obj;
+				if ( highlightGetRules ( interp, buffer, objv[cmdNo+1], &rules, &no ) != TCL_OK )
+				{
+					return TCL_ERROR;
+				}
 
-		/*  get the offset position for the inserted text*/
-		gtk_text_buffer_get_iter_at_offset ( buffer, &start, startOffset );
-		gtk_text_buffer_get_iter_at_offset ( buffer, &end, endOffset );
+				if ( hl != NULL )
+				{
+					/*  drop the old tags before the rules are replaced */
+					highlightClearLines ( hl, 0, gtk_text_buffer_get_line_count ( buffer ) - 1 );
+					g_object_set_data ( G_OBJECT ( buffer ), "gnocl::highlight", NULL );
+				}
 
-		if ( Tcl_ListObjLength ( interp, obj, &no ) != TCL_OK ) goto clearExit;
+				hl = g_new0 ( TextHighlight, 1 );
+				hl->buffer = buffer;
+				hl->rules = rules;
+				hl->noRules = no;
+				hl->budget = budget;
+				hl->lineCount = gtk_text_buffer_get_line_count ( buffer );
+				hl->lineStates = g_array_new ( 0, 1, sizeof ( int ) );
+				g_array_set_size ( hl->lineStates, hl->lineCount );
+				hl->dirtyStart = -1;
 
-		/*  apply each tag in turn */
-		for ( k = 0; k < no; ++k )
-		{
-			Tcl_Obj *tp;
+				g_signal_connect_after ( G_OBJECT ( buffer ), "insert-text", G_CALLBACK ( highlightOnInsertText ), hl );
+				g_signal_connect_after ( G_OBJECT ( buffer ), "delete-range", G_CALLBACK ( highlightOnDeleteRange ), hl );
+				g_signal_connect_after ( G_OBJECT ( buffer ), "insert-pixbuf", G_CALLBACK ( highlightOnInsertObject ), hl );
+				g_signal_connect_after ( G_OBJECT ( buffer ), "insert-child-anchor", G_CALLBACK ( highlightOnInsertObject ), hl );
 
-			if ( Tcl_ListObjIndex ( interp, obj, k, &tp ) != TCL_OK )
+				g_object_set_data_full ( G_OBJECT ( buffer ), "gnocl::highlight", hl, highlightFree );
+
+				highlightSchedule ( hl, 0, hl->lineCount - 1 );
+			}
+
+			break;
+		case RefreshIdx:
 			{
-				Tcl_SetResult ( interp, "Could not read tag list", TCL_STATIC );
-				goto clearExit;
+				if ( hl != NULL )
+				{
+					highlightSchedule ( hl, 0, hl->lineCount - 1 );
+				}
 			}
 
-			gtk_text_buffer_remove_tag_by_name ( buffer, Tcl_GetString ( tp ), &start, &end );
+			break;
+		case ClearIdx:
+			{
+				if ( hl != NULL )
+				{
+					highlightClearLines ( hl, 0, gtk_text_buffer_get_line_count ( buffer ) - 1 );
+					g_object_set_data ( G_OBJECT ( buffer ), "gnocl::highlight", NULL );
+				}
+			}
 
-		}
+			break;
 	}
 
-	ret = TCL_OK;
-
-clearExit:
-	gnoclClearOptions ( insertOptions );
-
-	return ret;
+	return TCL_OK;
 }
 
 /**
@@ -1340,8 +2430,8 @@ int tagCmd ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc, Tcl_Obj *  con
 
 	// const char *cmds[] = { "create", "configure", "add", "delete", "remove", NULL };
 	// enum cmdIdx { CreateIdx, ConfigureIdx, AddIdx, DeleteIdx};
-	const char *cmds[] = { "cget", "create", "configure", "apply", "delete", "remove", "get", NULL };
-	enum cmdIdx { CgetIdx, CreateIdx, ConfigureIdx, ApplyIdx, DeleteIdx, RemoveIdx, GetIdx };
+	const char *cmds[] = { "cget", "create", "configure", "apply", "delete", "remove", "get", "applyRanges", "removeRanges", NULL };
+	enum cmdIdx { CgetIdx, CreateIdx, ConfigureIdx, ApplyIdx, DeleteIdx, RemoveIdx, GetIdx, ApplyRangesIdx, RemoveRangesIdx };
 
 	/*  see also list.c */
 	GnoclOption tagOptions[] =
@@ -1460,9 +2550,14 @@ int tagCmd ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc, Tcl_Obj *  con
 					return TCL_ERROR;
 				}
 
-				/*  tag = gtk_text_tag_new( Tcl_GetString( objv[3] ) ); */
-				tag = gtk_text_buffer_create_tag ( buffer, Tcl_GetString ( objv[cmdNo+1] ), NULL );
-
+				/*  a shared tag table may already hold the definition, reconfigure it */
+				tag = gtk_text_tag_table_lookup ( gtk_text_buffer_get_tag_table ( buffer ), Tcl_GetString ( objv[cmdNo+1] ) );
+
+				if ( tag == NULL )
+				{
+					tag = gtk_text_buffer_create_tag ( buffer, Tcl_GetString ( objv[cmdNo+1] ), NULL );
+				}
+
 				ret = gnoclParseAndSetOptions ( interp, objc - cmdNo - 1, objv + cmdNo + 1, tagOptions, G_OBJECT ( tag ) );
 
 				gnoclClearOptions ( tagOptions );
@@ -1513,6 +2608,14 @@ int tagCmd ( GtkTextBuffer *buffer, Tcl_Interp *interp, int objc, Tcl_Obj *  con
 				break;
 			}
 
+		case ApplyRangesIdx:
+		case RemoveRangesIdx:
+			{
+				if ( tagRanges ( buffer, interp, objc, objv, cmdNo + 1, idx == ApplyRangesIdx ) != TCL_OK ) return -1;
+
+				break;
+			}
+
 		case DeleteIdx:
 			{
 				/*! WJG Added 28/03/08 */
@@ -1743,6 +2846,12 @@ static int configure ( Tcl_Interp *interp, GtkScrolledWindow *scrolled, GtkTextV
 	GtkTextBuffer *buffer;
 	buffer = gtk_text_view_get_buffer ( text );
 
+	if ( options[tagTableIdx].status == GNOCL_STATUS_CHANGED
+			&& gnoclCheckTagTable ( interp, buffer, options[tagTableIdx].val.str ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
 	/*
 	    gnoclAttacheOptCmdAndVar (
 	        &options[onChangedIdx], &para->onChanged,
@@ -1807,7 +2916,7 @@ static int cget ( Tcl_Interp *interp, GtkTextView *text, GnoclOption options[],
 */
 
 /**
-\brief      Return list of tag settings and their values in the format
+\brief      Append the settings of a tag and their values to the list in data, in the format
             { tagName1 {attribute-list} tagName2 {attribute-list}..  }
 \author     William J Giddings
 \date       24/Oct/2008
@@ -1816,53 +2925,20 @@ static int cget ( Tcl_Interp *interp, GtkTextView *text, GnoclOption options[],
             An alternative way of getting the colour values but this time in hex is:
             GdkColor *bg_color2  = &tag_appearance->bg_color;
             char *clr = gdk_color_to_string ( bg_color2 );
-            sprintf ( tmp2, "clr = %s ",clr);
-\todo       How do I get the results of this back to the calling function?
-            Data is assigned to the memory block referenced by gpointer data.
+            2) The list is built directly as Tcl_Obj, no intermediate string buffers.
 **/
 static void gnoclGetTagSettings ( GtkTextTag *tag, gpointer data )
 {
-
-	char **str = data;
-
-	/*  modify the memory allocation here to use malloc and free to release it */
-
-	static char tmp[300];
-	static char tmp2[50];
-
-	/*  if null arguments are sent, then clear buffers, and return */
+	Tcl_Obj *resList = ( Tcl_Obj * ) data;
+	Tcl_Obj *attrs;
+	GtkTextAppearance *tag_appearance;
 
 	if ( tag == NULL || data == NULL )
 	{
-		sprintf ( tmp, "" );
-		sprintf ( tmp2, "" );
-		return ;
+		return;
 	}
 
-	// GtkTextAttributes *tag_attributes=tag->values;
-	GtkTextAppearance *tag_appearance;
-
-	/*  get the info on the GtkTextTag union form gtktexttag.h */
-	strcat ( tmp, "" );
-
-	sprintf ( tmp2, "%s { ", tag->name );
-
-	strcat ( tmp, tmp2 );
-
-	strcat ( tmp, "priority " );
-
-	sprintf ( tmp2, "%d ", tag->priority );
-
-	strcat ( tmp, tmp2 );
-
-	/*  test some of these settings */
-
-	/*  Individual chunks of this can be set/unset as a group */
-	PangoFontDescription *font;
-
-	GtkTextDirection direction;
-
-	guint realized;
+	attrs = Tcl_NewListObj ( 0, NULL );
 
 	/*    -----------------------------------------------
 	 *  get a handle on the tag appearance structure
@@ -1872,189 +2948,396 @@ static void gnoclGetTagSettings ( GtkTextTag *tag, gpointer data )
 	 *  only return these values if they have been changed from
 	 *  system defaults.
 	 *    -----------------------------------------------*/
-	tag_appearance = tag->values;
+	tag_appearance = &tag->values->appearance;
+
+	Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "priority", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->priority ) );
 
 	/*  background colour */
 	if ( tag->bg_color_set )
 	{
-		GdkColor bg_color  = tag_appearance->bg_color;
-		/*  build up the output list */
-		strcat ( tmp, "bg_color" );
-		sprintf ( tmp2, " { %d %d %d } ", bg_color.red, bg_color.green, bg_color.blue );
-		strcat ( tmp, tmp2 );
-	}
+		Tcl_Obj *clr[3];
 
-	/*  background stipple */
-
-	if ( tag->bg_stipple_set )
-	{
-		GdkBitmap *bg_stipple  = tag_appearance->bg_stipple;
+		clr[0] = Tcl_NewIntObj ( tag_appearance->bg_color.red );
+		clr[1] = Tcl_NewIntObj ( tag_appearance->bg_color.green );
+		clr[2] = Tcl_NewIntObj ( tag_appearance->bg_color.blue );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "bg_color", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewListObj ( 3, clr ) );
 	}
 
 	/*  foreground colour */
-
 	if ( tag->fg_color_set )
 	{
-		GdkColor fg_color  = tag_appearance->fg_color;
-		/*  build up the output list */
-		strcat ( tmp, "fg_color" );
-		sprintf ( tmp2, " { %d %d %d } ", fg_color.red, fg_color.green, fg_color.blue );
-		strcat ( tmp, tmp2 );
+		Tcl_Obj *clr[3];
+
+		clr[0] = Tcl_NewIntObj ( tag_appearance->fg_color.red );
+		clr[1] = Tcl_NewIntObj ( tag_appearance->fg_color.green );
+		clr[2] = Tcl_NewIntObj ( tag_appearance->fg_color.blue );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "fg_color", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewListObj ( 3, clr ) );
 	}
 
 	/*  font scaling */
-
 	if ( tag->scale_set )
 	{
-		strcat ( tmp, "font_scale" );
-		sprintf ( tmp2, " %d ", tag->values->font_scale );
-		strcat ( tmp, tmp2 );
-	}
-
-	/*  foreground stipple */
-
-	if ( tag->fg_stipple_set )
-	{
-		GdkBitmap *fg_stipple = tag_appearance->fg_stipple;
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "font_scale", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewDoubleObj ( tag->values->font_scale ) );
 	}
 
-	/*  text justfification */
-
+	/*  text justfification, GTK_JUSTIFY_LEFT | GTK_JUSTIFY_RIGHT | GTK_JUSTIFY_CENTER | GTK_JUSTIFY_FILL */
 	if ( tag->justification_set )
 	{
-		// GTK_JUSTIFY_LEFT | GTK_JUSTIFY_RIGHT | GTK_JUSTIFY_CENTER | GTK_JUSTIFY_FILL
-		strcat ( tmp, "justification" );
-		sprintf ( tmp2, " %d ", tag->values->justification );
-		strcat ( tmp, tmp2 );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "justification", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->justification ) );
 	}
 
 	/*  default indent */
-
 	if ( tag->indent_set )
 	{
-		strcat ( tmp, "indent" );
-		sprintf ( tmp2, " %d ", tag->values->indent );
-		strcat ( tmp, tmp2 );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "indent", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->indent ) );
 	}
 
 	/*  text rise, i.e. for superscript */
-
 	if ( tag->rise_set )
 	{
-		gint rise = tag_appearance->rise;
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "rise", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag_appearance->rise ) );
 	}
 
 	/*  strikethrough or, overstrike */
-
 	if ( tag->strikethrough_set )
 	{
-		guint strikethrough = tag_appearance->strikethrough;
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "strikethrough", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag_appearance->strikethrough ) );
 	}
 
-	if ( tag->right_margin_set )
+	if ( tag->left_margin_set )
 	{
-		strcat ( tmp, "right_margin" );
-		sprintf ( tmp2, " %d ", tag->values->right_margin );
-		strcat ( tmp, tmp2 );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "left_margin", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->left_margin ) );
 	}
 
 	if ( tag->right_margin_set )
 	{
-		//gint right_margin = tag->values->right_margin;
-		//printf ( "right_margin\t%d\n", tag->values->right_margin );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "right_margin", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->right_margin ) );
 	}
 
 	if ( tag->pixels_above_lines_set )
 	{
-		strcat ( tmp, "pixels_above_lines" );
-		sprintf ( tmp2, " %d ", tag->values->pixels_above_lines );
-		strcat ( tmp, tmp2 );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "pixels_above_lines", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->pixels_above_lines ) );
 	}
 
 	if ( tag->pixels_below_lines_set )
 	{
-		strcat ( tmp, "pixels_below_lines" );
-		sprintf ( tmp2, " %d ", tag->values->pixels_below_lines );
-		strcat ( tmp, tmp2 );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "pixels_below_lines", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->pixels_below_lines ) );
 	}
 
 	if ( tag->pixels_inside_wrap_set )
 	{
-		//gint pixels_inside_wrap = tag_attributes->pixels_inside_wrap;
-		//printf ( "pixels_inside_wrap\t%d\n", tag->values->pixels_inside_wrap );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "pixels_inside_wrap", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->pixels_inside_wrap ) );
 	}
 
-	if ( tag->tabs_set )
+	/*  PangoUnderline */
+	if ( tag->underline_set )
 	{
-		PangoTabArray *tabs = tag->values->tabs;
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "underline", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag_appearance->underline ) );
 	}
 
-	if ( tag->underline_set )
+	/*  GTK_WRAP_NONE, GTK_WRAP_CHAR, GTK_WRAP_WORD, GTK_WRAP_WORD_CHAR */
+	if ( tag->wrap_mode_set )
 	{
-		guint underline = tag_appearance->underline;          /*  PangoUnderline */
-		//printf ( "underline\t%d\n", tag_appearance->underline );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "wrap_mode", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->wrap_mode ) );
 	}
 
-	if ( tag->wrap_mode_set )
+	if ( tag->invisible_set )
 	{
-		GtkWrapMode wrap_mode;  /*  How to handle wrap-around for this tag.
-                                 *  Must be GTK_WRAPMODE_CHAR,
-                                 *  GTK_WRAPMODE_NONE, GTK_WRAPMODE_WORD
-                                 */
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "invisible", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->invisible ) );
 	}
 
-	if ( tag->bg_full_height_set )
+	/*  can edit this text */
+	if ( tag->editable_set )
 	{
-		/*  Background is fit to full line height rather than
-		 *  baseline +/- ascent/descent (font height)
-		*/
-		guint bg_full_height;
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewStringObj ( "editable", -1 ) );
+		Tcl_ListObjAppendElement ( NULL, attrs, Tcl_NewIntObj ( tag->values->editable ) );
 	}
 
-	if ( tag->invisible_set )
+	Tcl_ListObjAppendElement ( NULL, resList, Tcl_NewStringObj ( tag->name != NULL ? tag->name : "", -1 ) );
+	Tcl_ListObjAppendElement ( NULL, resList, attrs );
+}
+
+/* what to report during a dump */
+enum
+{
+	DUMP_TEXT    = 1 << 0,
+	DUMP_TAGS    = 1 << 1,
+	DUMP_MARKS   = 1 << 2,
+	DUMP_IMAGES  = 1 << 3,
+	DUMP_WINDOWS = 1 << 4,
+	DUMP_ALL     = DUMP_TEXT | DUMP_TAGS | DUMP_MARKS | DUMP_IMAGES | DUMP_WINDOWS
+};
+
+/**
+\brief      Collects the flat { key value index ... } list of a dump.
+\note       The elements are gathered in a growing array and turned into
+            a list object in one go at the end.
+**/
+typedef struct
+{
+	GPtrArray   *elems;
+	int         flags;
+	GtkTextIter textStart;          /* start of not yet reported text */
+	GHashTable  *openTags;          /* tags switched on but not yet off */
+} DumpData;
+
+/**
+**/
+static Tcl_Obj *iterToIndexObj ( GtkTextIter *iter )
+{
+	Tcl_Obj *idx[2];
+
+	idx[0] = Tcl_NewIntObj ( gtk_text_iter_get_line ( iter ) );
+	idx[1] = Tcl_NewIntObj ( gtk_text_iter_get_line_offset ( iter ) );
+
+	return Tcl_NewListObj ( 2, idx );
+}
+
+/**
+**/
+static void dumpAppend ( DumpData *dd, const char *key, Tcl_Obj *value, Tcl_Obj *index )
+{
+	g_ptr_array_add ( dd->elems, Tcl_NewStringObj ( key, -1 ) );
+	g_ptr_array_add ( dd->elems, value );
+	g_ptr_array_add ( dd->elems, index );
+}
+
+/**
+\brief      Report the text between dd->textStart and iter as one item, if text is asked for.
+**/
+static void dumpFlushText ( DumpData *dd, GtkTextIter *iter )
+{
+	if ( ( dd->flags & DUMP_TEXT ) && gtk_text_iter_compare ( &dd->textStart, iter ) < 0 )
 	{
-		guint invisible = tag->values->invisible;
+		/*  get_text leaves out pixbufs and child anchors */
+		char *txt = gtk_text_iter_get_text ( &dd->textStart, iter );
+		dumpAppend ( dd, "text", Tcl_NewStringObj ( txt, -1 ), iterToIndexObj ( &dd->textStart ) );
+		g_free ( txt );
 	}
 
-	if ( tag->editable_set )
+	dd->textStart = *iter;
+}
+
+/**
+**/
+static void dumpTagList ( DumpData *dd, const char *key, GSList *tags, GtkTextIter *iter, int on )
+{
+	GSList *p;
+
+	for ( p = tags; p != NULL; p = p->next )
+	{
+		GtkTextTag *tag = GTK_TEXT_TAG ( p->data );
+
+		if ( on )
+		{
+			g_hash_table_insert ( dd->openTags, tag, tag );
+		}
+
+		else if ( !g_hash_table_remove ( dd->openTags, tag ) )
+		{
+			/*  switched on before the start of the range */
+			continue;
+		}
+
+		dumpAppend ( dd, key, Tcl_NewStringObj ( tag->name != NULL ? tag->name : "", -1 ), iterToIndexObj ( iter ) );
+	}
+
+	g_slist_free ( tags );
+}
+
+/**
+**/
+static void dumpCloseTag ( gpointer key, gpointer value, gpointer data )
+{
+	DumpData *dd = ( DumpData * ) data;
+	GtkTextTag *tag = GTK_TEXT_TAG ( key );
+
+	dumpAppend ( dd, "tagoff", Tcl_NewStringObj ( tag->name != NULL ? tag->name : "", -1 ), iterToIndexObj ( &dd->textStart ) );
+}
+
+/**
+**/
+static gboolean isObjectChar ( gunichar ch, gpointer data )
+{
+	return ch == GTK_TEXT_UNKNOWN_CHAR;
+}
+
+/**
+\brief      Report everything at position iter which is selected by flags.
+**/
+static void dumpAt ( DumpData *dd, GtkTextIter *iter, int flags, int isStart )
+{
+	if ( flags & DUMP_TAGS )
 	{
-		/*  can edit this text */
-		guint editable = tag->values->editable;
+		GSList *off = isStart ? NULL : gtk_text_iter_get_toggled_tags ( iter, 0 );
+		GSList *on = isStart ? gtk_text_iter_get_tags ( iter ) : gtk_text_iter_get_toggled_tags ( iter, 1 );
+
+		if ( off != NULL || on != NULL )
+		{
+			dumpFlushText ( dd, iter );
+			dumpTagList ( dd, "tagoff", off, iter, 0 );
+			dumpTagList ( dd, "tagon", on, iter, 1 );
+		}
 	}
 
-	if ( tag->language_set )
+	if ( flags & DUMP_MARKS )
 	{
-		PangoLanguage *language;
+		GSList *marks = gtk_text_iter_get_marks ( iter );
+		GSList *p;
+
+		for ( p = marks; p != NULL; p = p->next )
+		{
+			const char *name = gtk_text_mark_get_name ( GTK_TEXT_MARK ( p->data ) );
+
+			/*  anonymous marks cannot be addressed from Tcl */
+			if ( name != NULL )
+			{
+				dumpFlushText ( dd, iter );
+				dumpAppend ( dd, "mark", Tcl_NewStringObj ( name, -1 ), iterToIndexObj ( iter ) );
+			}
+		}
+
+		g_slist_free ( marks );
 	}
 
-	if ( tag->pg_bg_color_set )
+	if ( ( flags & ( DUMP_IMAGES | DUMP_WINDOWS ) ) && gtk_text_iter_get_char ( iter ) == GTK_TEXT_UNKNOWN_CHAR )
 	{
-		/*< public >*/
-		GdkColor bg_color = tag_appearance->bg_color;
+		GdkPixbuf *pixbuf = gtk_text_iter_get_pixbuf ( iter );
+		GtkTextChildAnchor *anchor = gtk_text_iter_get_child_anchor ( iter );
+
+		if ( pixbuf != NULL && ( flags & DUMP_IMAGES ) )
+		{
+			const char *name = gnoclGetNameFromPixBuf ( pixbuf );
+
+			dumpFlushText ( dd, iter );
+			dumpAppend ( dd, "image", Tcl_NewStringObj ( name != NULL ? name : "", -1 ), iterToIndexObj ( iter ) );
+		}
+
+		if ( anchor != NULL && ( flags & DUMP_WINDOWS ) )
+		{
+			GList *widgets = gtk_text_child_anchor_get_widgets ( anchor );
+			GList *p;
+
+			dumpFlushText ( dd, iter );
+
+			for ( p = widgets; p != NULL; p = p->next )
+			{
+				const char *name = gnoclGetNameFromWidget ( GTK_WIDGET ( p->data ) );
+				dumpAppend ( dd, "window", Tcl_NewStringObj ( name != NULL ? name : "", -1 ), iterToIndexObj ( iter ) );
+			}
+
+			g_list_free ( widgets );
+		}
 	}
+}
+
+/**
+\brief      Walk the range start..end once and return a flat list of
+            { key value index ... } as known from the Tk text dump.
+            key is one of text, tagon, tagoff, mark, image or window.
+\note       Without marks the walk jumps from tag toggle to tag toggle
+            and from object to object, marks need a look at every position.
+            Tags switched on before the start of the range are reported as
+            tagon at start, tags still switched on as tagoff at end.
+**/
+static Tcl_Obj *dumpRange ( GtkTextBuffer *buffer, GtkTextIter *start, GtkTextIter *end, int flags )
+{
+	DumpData    dd;
+	GtkTextIter iter = *start;
+	GtkTextIter object = *start;
+	Tcl_Obj     *resList;
+
+	/*  a rough guess to avoid most of the reallocations */
+	dd.elems = g_ptr_array_sized_new ( 3 * ( 1 + gtk_text_iter_get_line ( end ) - gtk_text_iter_get_line ( start ) ) );
+	dd.flags = flags;
+	dd.textStart = *start;
+	dd.openTags = g_hash_table_new ( g_direct_hash, g_direct_equal );
+
+	dumpAt ( &dd, &iter, flags, 1 );
+
+	while ( gtk_text_iter_compare ( &iter, end ) < 0 )
+	{
+		if ( flags & DUMP_MARKS )
+		{
+			gtk_text_iter_forward_char ( &iter );
+		}
+
+		else
+		{
+			GtkTextIter next = iter;
+
+			if ( flags & DUMP_TAGS )
+			{
+				gtk_text_iter_forward_to_tag_toggle ( &next, NULL );
+			}
+
+			else
+			{
+				next = *end;
+			}
+
+			if ( flags & ( DUMP_IMAGES | DUMP_WINDOWS ) )
+			{
+				/*  the next object is only searched for again once it is passed */
+				if ( gtk_text_iter_compare ( &object, &iter ) <= 0 )
+				{
+					object = iter;
+
+					if ( !gtk_text_iter_forward_find_char ( &object, isObjectChar, NULL, end ) )
+					{
+						object = *end;
+					}
+				}
+
+				if ( gtk_text_iter_compare ( &object, &next ) < 0 )
+				{
+					next = object;
+				}
+			}
+
+			if ( gtk_text_iter_compare ( &next, end ) > 0 )
+			{
+				next = *end;
+			}
+
+			iter = next;
+		}
 
-	/*  Whether to use background-related values; this is irrelevant for
-	 *  the values struct when in a tag, but is used for the composite
-	 *  values struct; it's true if any of the tags being composited
-	 *  had background stuff set.
-	 */
-	guint draw_bg = tag_appearance->draw_bg;
+		if ( gtk_text_iter_compare ( &iter, end ) < 0 )
+		{
+			dumpAt ( &dd, &iter, flags, 0 );
+		}
+	}
 
-	/*  These are only used when we are actually laying out and rendering
-	 *  a paragraph; not when a GtkTextAppearance is part of a
-	 *  GtkTextAttributes.
-	 */
-	guint inside_selection = tag_appearance->inside_selection;
+	dumpFlushText ( &dd, end );
 
-	guint is_text = tag_appearance->is_text;
+	if ( flags & DUMP_TAGS )
+	{
+		g_hash_table_foreach ( dd.openTags, dumpCloseTag, &dd );
+	}
 
+	g_hash_table_destroy ( dd.openTags );
 
-	/*  update string */
-	// sprintf ( tmp2, " %d ", tag->values->pixels_below_lines );
-	strcat ( tmp, "} " );
+	resList = Tcl_NewListObj ( dd.elems->len, ( Tcl_Obj ** ) dd.elems->pdata );
+	g_ptr_array_free ( dd.elems, 1 );
 
-	//g_print("tmp >>> = %s\n",tmp);
-	*str = tmp;
+	return resList;
 }
 
 /**
@@ -2103,14 +3386,16 @@ int gnoclTextCommand (
 						   "cut", "copy", "paste", "cget", "getLineCount", "getWordLength", "getLength", "getLineLength",
 						   "setCursor", "getCursor", "insert", "tag", "dump", "XYgetCursor", "signalEmit", "mark",
 						   "gotoWordStart", "gotoWordEnd", "search", "class", "spawn", "parent", "replace",
-						   "serialize", "deSerialize", "save", "load", "print", "getIndex", "getCoords", "getRect", "lorem", NULL
+						   "serialize", "deSerialize", "save", "load", "print", "getIndex", "getCoords", "getRect", "lorem",
+						   "getIndices", "getRanges", "highlight", NULL
 						 };
 
 	enum cmdIdx {   DeleteIdx, ConfigureIdx, ScrollToPosIdx, ScrollToMarkIdx, SetIdx, EraseIdx, SelectIdx, GetIdx,
 					CutIdx, CopyIdx, PasteIdx, CgetIdx, GetLineCountIdx, GetWordLengthIdx, GetLengthIdx, GetLineLengthIdx,
 					SetCursorIdx, GetCursorIdx, InsertIdx, TagIdx, DumpIdx, XYgetCursorIdx, SignalEmitIdx, MarkIdx,
 					GotoWordStartIdx, GotoWordEndIdx, SearchIdx, ClassIdx, SpawnIdx, ParentIdx, ReplaceIdx,
-					SerializeIdx, DeSerializeIdx, SaveIdx, LoadIdx, PrintIdx, GetIndexIdx, GetCoordsIdx, GetRectIdx, LoremIdx
+					SerializeIdx, DeSerializeIdx, SaveIdx, LoadIdx, PrintIdx, GetIndexIdx, GetCoordsIdx, GetRectIdx, LoremIdx,
+					GetIndicesIdx, GetRangesIdx, HighlightIdx
 				};
 
 	int   idx;
@@ -2148,6 +3433,38 @@ int gnoclTextCommand (
 		case GetRectIdx:        return 8;
 
 			/* these are GtkTextBuffer operation */
+		case GetIndicesIdx:
+			{
+				/*  text getIndices {index index ...} */
+				if ( objc != cmdNo + 2 )
+				{
+					Tcl_WrongNumArgs ( interp, cmdNo + 1, objv, "indexList" );
+					return -1;
+				}
+
+				if ( getIndices ( buffer, interp, objv[cmdNo+1] ) != TCL_OK )
+				{
+					return -1;
+				}
+			}
+
+			break;
+		case GetRangesIdx:
+			{
+				/*  text getRanges {startIndex endIndex startIndex endIndex ...} */
+				if ( objc != cmdNo + 2 )
+				{
+					Tcl_WrongNumArgs ( interp, cmdNo + 1, objv, "rangeList" );
+					return -1;
+				}
+
+				if ( getRanges ( buffer, interp, objv[cmdNo+1] ) != TCL_OK )
+				{
+					return -1;
+				}
+			}
+
+			break;
 		case LoremIdx:
 			{
 
@@ -2737,86 +4054,65 @@ int gnoclTextCommand (
 
 			break;
 
+		case HighlightIdx:
+
+			if ( highlightCmd ( buffer, interp, objc, objv, cmdNo + 1 ) != TCL_OK )
+			{
+				return -1;
+			}
+
+			break;
+
 			/*  the widget dump has the format;
-			 *  widgetId dump option startIndex endIndx
+			 *  widgetId dump option ?startIndex? ?endIndex?
 			 */
 		case DumpIdx:
 			{
-				/*  some debugging feedback */
-
-				//g_print("intc = %d\n",objc);
-#ifdef DEBUG
-				printf ( "dump: %d %d: %s %s %s %s \n",
-						 objc, cmdNo + 4,
-						 Tcl_GetString ( objv[cmdNo] ),
-						 Tcl_GetString ( objv[cmdNo+1] ),
-						 Tcl_GetString ( objv[cmdNo+2] ),
-						 Tcl_GetString ( objv[cmdNo+3] ) ) ;
-#endif
-
 				GtkTextIter startIter, endIter;
-
-				GtkTextTagTable *tagtable;
 				char *txt;
 				int idx;
-				static const char *cmds[] = { "all", "tags", "text", "windows", "images", "marks", NULL };
-				enum opts {AllIdx, TagsIdx, TextIdx, WindowsIdx, ImagesIdx, MarksIdx};
-
+				static const char *cmds[] = { "all", "tags", "text", "windows", "images", "marks", "toggles", NULL };
+				enum opts {AllIdx, TagsIdx, TextIdx, WindowsIdx, ImagesIdx, MarksIdx, TogglesIdx};
+				const int flags[] = { DUMP_ALL, 0, DUMP_TEXT, DUMP_WINDOWS, DUMP_IMAGES, DUMP_MARKS, DUMP_TAGS };
 
 				/*  do some error checking */
 
-				if ( objc < cmdNo + 4 )
+				if ( objc < cmdNo + 2 || objc > cmdNo + 4 )
 				{
-					Tcl_WrongNumArgs ( interp, cmdNo + 1, objv, "?all|text|tags|window|images|marks? startIndex ?endIndex?" );
+					Tcl_WrongNumArgs ( interp, cmdNo + 1, objv, "all|text|tags|toggles|windows|images|marks ?startIndex? ?endIndex?" );
 					return TCL_ERROR;
 				}
 
-				/*  get iters for the required range */
+				/*  get the sub-command, one of all, tags, text, images, marks */
 
-				if ( posToIter ( interp, objv[cmdNo+2], buffer, &startIter ) != TCL_OK )
+				if ( Tcl_GetIndexFromObj ( interp, objv[cmdNo+1], cmds, "subcommand", TCL_EXACT, &idx ) != TCL_OK )
 				{
 					return TCL_ERROR;
 				}
 
-				if ( posToIter ( interp, objv[cmdNo+3], buffer, &endIter ) != TCL_OK )
+				/*  get iters for the required range, default is the whole buffer */
+				gtk_text_buffer_get_bounds ( buffer, &startIter, &endIter );
+
+				if ( objc > cmdNo + 2 && posToIter ( interp, objv[cmdNo+2], buffer, &startIter ) != TCL_OK )
 				{
 					return TCL_ERROR;
 				}
 
-				/*  get the sub-command, one of all, tags, text, images, marks */
-
-				if ( Tcl_GetIndexFromObj ( interp, objv[cmdNo+1], cmds, "subcommand", TCL_EXACT, &idx ) != TCL_OK )
+				if ( objc > cmdNo + 3 && posToIter ( interp, objv[cmdNo+3], buffer, &endIter ) != TCL_OK )
 				{
 					return TCL_ERROR;
 				}
 
-				/*
-				 *  Respond to the second keyword..
-				 */
+				gtk_text_iter_order ( &startIter, &endIter );
 
 				switch ( idx )
 				{
-					case AllIdx:
-						{
-							txt = "dump all... Feature not yet implmented\n";
-							Tcl_SetObjResult ( interp, Tcl_NewStringObj ( txt, -1 ) );
-							return TCL_OK;
-						}
-
-						break;
 					case TagsIdx:
 						{
-							//g_print ( "dump tags\n" );
-							GtkTextTagTable *tagtable = gtk_text_buffer_get_tag_table ( buffer );
-
-							/*  get the settings of each tag in the buffer*/
-							/*  note, pass the address of the pointer to the data assigned by the called function */
-							gtk_text_tag_table_foreach ( tagtable, gnoclGetTagSettings , &txt );
-
-							Tcl_SetObjResult ( interp, Tcl_NewStringObj ( txt, -1 ) );
-							/*  reset the outsput string by using null pointers */
-							gnoclGetTagSettings ( NULL, NULL );
-							return TCL_OK;
+							/*  get the settings of each tag in the buffer */
+							Tcl_Obj *resList = Tcl_NewListObj ( 0, NULL );
+							gtk_text_tag_table_foreach ( gtk_text_buffer_get_tag_table ( buffer ), gnoclGetTagSettings, resList );
+							Tcl_SetObjResult ( interp, resList );
 						}
 
 						break;
@@ -2825,58 +4121,15 @@ int gnoclTextCommand (
 							/*  TODO: include_hidden_chars */
 							txt = gtk_text_buffer_get_text ( buffer, &startIter, &endIter, 1 );
 							Tcl_SetObjResult ( interp, Tcl_NewStringObj ( txt, -1 ) );
-							return TCL_OK;
-						}
-
-						break;
-					case WindowsIdx:
-						{
-							txt = "dump windows... Feature not yet implmented\n";
-							Tcl_SetObjResult ( interp, Tcl_NewStringObj ( txt, -1 ) );
-							return TCL_OK;
-						}
-
-						break;
-					case ImagesIdx:
-						{
-							txt = "dump images... Feature not yet implmented\n";
-							Tcl_SetObjResult ( interp, Tcl_NewStringObj ( txt, -1 ) );
-							return TCL_OK;
-						}
-
-						break;
-					case MarksIdx:
-						{
-							txt = "dump marks... Feature not yet implmented\n";
-							Tcl_SetObjResult ( interp, Tcl_NewStringObj ( txt, -1 ) );
-							return TCL_OK;
+							g_free ( txt );
 						}
 
 						break;
 					default:
 						{
-							assert ( 0 );
+							Tcl_SetObjResult ( interp, dumpRange ( buffer, &startIter, &endIter, flags[idx] ) );
 						}
 				}
-
-				return TCL_OK;
-
-
-
-
-				// gint gtk_text_tag_table_get_size (GtkTextTagTable *table);
-				int tagTableSize = gtk_text_tag_table_get_size ( tagtable );
-
-				printf ( "~tagTableSize~    %d\n", tagTableSize );
-
-				// void gtk_text_tag_table_foreach (GtkTextTagTable *table, GtkTextTagTableForeach func, gpointer data);
-				//gtk_text_tag_table_foreach ( tagtable, testPrint , NULL );
-
-				//GtkTextTag*  gtk_text_tag_table_lookup (GtkTextTagTable *table, const gchar *name);
-				GtkTextTag *tag = gtk_text_tag_table_lookup ( tagtable, "_tag_rollOver" );
-#ifdef DEBUG
-				printf ( "~~tag~   %s\n", tag );
-#endif
 			}
 
 			break;
@@ -3129,7 +4382,20 @@ int gnoclTextCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj *  con
 		return TCL_ERROR;
 	}
 
-	textView = GTK_TEXT_VIEW ( gtk_text_view_new( ) );
+	if ( textOptions[tagTableIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		GtkTextTagTable *table = gnoclGetTagTable ( textOptions[tagTableIdx].val.str );
+		GtkTextBuffer *buffer = gtk_text_buffer_new ( table );
+
+		textView = GTK_TEXT_VIEW ( gtk_text_view_new_with_buffer ( buffer ) );
+		g_object_unref ( buffer );
+		g_object_unref ( table );
+	}
+
+	else
+	{
+		textView = GTK_TEXT_VIEW ( gtk_text_view_new( ) );
+	}
 
 	/*  add some extra signals to the default setting */
 	gtk_widget_add_events ( textView, GDK_ENTER_NOTIFY_MASK | GDK_LEAVE_NOTIFY_MASK );
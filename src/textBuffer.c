@@ -22,12 +22,14 @@
 
 static const int textIdx = 0;
 static const int Option2Idx = 1;
+static const int tagTableIdx = 2;
 
 static GnoclOption textBufferOptions[] =
 {
 	/*  widget custom options, later processed by configure */
 	{ "-text", GNOCL_STRING, NULL },      /* option1Idx = 0 */
 	{ "-option2", GNOCL_STRING, NULL},       /* option2Idx = 1 */
+	{ "-tagTable", GNOCL_STRING, NULL},      /* tagTableIdx = 2 */
 
 	/* class specific properties go here */
 
@@ -63,6 +65,12 @@ static int cget ( Tcl_Interp *interp, GtkTextBuffer *widget, GnoclOption options
 static int configure ( Tcl_Interp *interp, GtkTextBuffer *widget, GnoclOption options[] )
 {
 
+	if ( options[tagTableIdx].status == GNOCL_STATUS_CHANGED
+			&& gnoclCheckTagTable ( interp, widget, options[tagTableIdx].val.str ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
 	if ( options[textIdx].status == GNOCL_STATUS_CHANGED )
 	{
 		printf ( "Insert some text at creation\n" );
@@ -187,7 +195,18 @@ int gnoclTextBufferCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj
 	}
 
 	/* 2) initialize the widget and set options passed from the interpreter */
-	widget = gtk_text_buffer_new ( NULL );
+	if ( textBufferOptions[tagTableIdx].status == GNOCL_STATUS_CHANGED )
+	{
+		/*  share the named table, the buffer holds its own reference */
+		GtkTextTagTable *table = gnoclGetTagTable ( textBufferOptions[tagTableIdx].val.str );
+		widget = gtk_text_buffer_new ( table );
+		g_object_unref ( table );
+	}
+
+	else
+	{
+		widget = gtk_text_buffer_new ( NULL );
+	}
 
 	/* a) apply base widget properties and signals */
 	ret = gnoclSetOptions ( interp, textBufferOptions, G_OBJECT ( widget ), -1 );
@@ -1240,9 +1240,7 @@ static int addItem ( GtkToolbar *toolbar, Tcl_Interp *interp,
 					return TCL_ERROR;
 				}
 
-				child = gnoclGetWidgetFromName ( Tcl_GetString ( objv[3] ),
-
-												 interp );
+				child = gnoclGetWidgetFromObj ( interp, objv[3] );
 
 				if ( child == NULL )
 				{
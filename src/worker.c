@@ -0,0 +1,641 @@
+/**
+**/
+
+/*
+ * This file implements a Tcl interface to GTK+ and Gnome
+ *
+ * See the file "license.terms" for information on usage and redistribution
+ * of this file, and for a DISCLAIMER OF ALL WARRANTIES.
+ *
+ */
+
+/*
+   History:
+   2026-10: begin of developement, create|post|delete
+*/
+
+/**
+\page page_worker gnocl::worker
+\section sec_worker Description
+	Runs a script in a separate Tcl interpreter on a pooled thread. The
+	worker has no access to GTK or gnocl widgets, it talks to the GUI
+	thread only through messages:
+\code
+	set w [gnocl::worker create {
+		gnocl::worker onMessage [list apply {{data} {
+			gnocl::worker post [string length $data]
+		}}]
+	} -onMessage [list apply {{id msg} { puts "$id: $msg" }}]]
+	gnocl::worker post $w [read $chan]
+	gnocl::worker delete $w
+\endcode
+	In the GUI interpreter:
+	<ul>
+	<li>create script ?-onMessage command? : returns the worker id; command
+		is called with the id and each message the worker posts</li>
+	<li>post id message</li>
+	<li>delete id : the worker finishes the event it is handling and exits</li>
+	</ul>
+	In the worker interpreter:
+	<ul>
+	<li>post message : queue message for the -onMessage command</li>
+	<li>onMessage ?command? : called with each message posted by the GUI</li>
+	<li>exit</li>
+	</ul>
+	Messages are copied between the threads as raw bytes. A ByteArray
+	stays a ByteArray and is never converted to or from UTF-8 on the way.
+**/
+
+#include "gnocl.h"
+#include <string.h>
+
+enum WorkerMessageType { MSG_STRING, MSG_BYTES, MSG_ERROR, MSG_QUIT };
+
+typedef struct Worker
+{
+	gchar         *name;
+	gchar         *script;
+	gint          refCount;
+
+	/* GUI thread */
+	Tcl_Interp    *guiInterp;
+	Tcl_Obj       *onMessage;
+	int           deleted;
+
+	/* worker thread */
+	Tcl_Interp    *interp;
+	Tcl_Obj       *handler;
+	GQueue        *pending;     /* messages waiting for a handler */
+	int           quit;
+
+	/* shared, thread and state are guarded by the workers lock */
+	GAsyncQueue   *inbox;
+	Tcl_ThreadId  thread;
+	int           running;
+	int           finished;
+} Worker;
+
+typedef struct
+{
+	Worker                 *worker;
+	enum WorkerMessageType type;
+	gchar                  *data;
+	int                    len;
+} WorkerMessage;
+
+typedef struct
+{
+	Tcl_Event header;
+	Worker    *worker;
+} WorkerEvent;
+
+G_LOCK_DEFINE_STATIC ( workers );
+
+/* GUI thread only */
+static GHashTable *name2worker = NULL;
+static GThreadPool *workerPool = NULL;
+static int workerCount = 0;
+
+static const Tcl_ObjType *byteArrayType = NULL;
+
+static Worker *workerRef ( Worker *worker )
+{
+	g_atomic_int_inc ( &worker->refCount );
+	return worker;
+}
+
+static void workerUnref ( Worker *worker )
+{
+	if ( !g_atomic_int_dec_and_test ( &worker->refCount ) )
+	{
+		return;
+	}
+
+	g_async_queue_unref ( worker->inbox );
+	g_free ( worker->name );
+	g_free ( worker->script );
+	g_free ( worker );
+}
+
+/**
+\brief      Copy obj into a message that may cross threads.
+\date       2026-10
+\note       Tcl_Objs belong to the thread which created them, only the bytes move.
+**/
+static WorkerMessage *messageNew ( Worker *worker, enum WorkerMessageType type, Tcl_Obj *obj )
+{
+	WorkerMessage *msg = g_new0 ( WorkerMessage, 1 );
+	const gchar *bytes = NULL;
+
+	msg->worker = workerRef ( worker );
+	msg->type = type;
+
+	if ( obj == NULL )
+	{
+		return msg;
+	}
+
+	if ( type == MSG_STRING && obj->typePtr == byteArrayType )
+	{
+		msg->type = MSG_BYTES;
+		bytes = ( const gchar * ) Tcl_GetByteArrayFromObj ( obj, &msg->len );
+	}
+
+	else
+	{
+		bytes = Tcl_GetStringFromObj ( obj, &msg->len );
+	}
+
+	msg->data = g_memdup ( bytes, msg->len );
+
+	return msg;
+}
+
+static Tcl_Obj *messageObj ( WorkerMessage *msg )
+{
+	if ( msg->type == MSG_BYTES )
+	{
+		return Tcl_NewByteArrayObj ( ( unsigned char * ) msg->data, msg->len );
+	}
+
+	return Tcl_NewStringObj ( msg->data, msg->len );
+}
+
+static void messageFree ( gpointer data )
+{
+	WorkerMessage *msg = data;
+
+	workerUnref ( msg->worker );
+	g_free ( msg->data );
+	g_free ( msg );
+}
+
+/**
+\brief      Idle callback in the GUI thread for a message posted by a worker.
+\date       2026-10
+**/
+static gboolean workerDeliver ( gpointer data )
+{
+	WorkerMessage *msg = data;
+	Worker *worker = msg->worker;
+	Tcl_Interp *interp = worker->guiInterp;
+
+	if ( worker->deleted )
+	{
+		return FALSE;
+	}
+
+	if ( msg->type == MSG_ERROR )
+	{
+		Tcl_ResetResult ( interp );
+		Tcl_AppendResult ( interp, "GNOCL ERROR: worker \"", worker->name, "\": ", ( char * ) NULL );
+		Tcl_AppendObjToObj ( Tcl_GetObjResult ( interp ), messageObj ( msg ) );
+		Tcl_BackgroundError ( interp );
+	}
+
+	else if ( worker->onMessage != NULL )
+	{
+		/* appended as list elements so that a ByteArray arrives unconverted */
+		Tcl_Obj *cmd = Tcl_DuplicateObj ( worker->onMessage );
+
+		Tcl_IncrRefCount ( cmd );
+		Tcl_ListObjAppendElement ( NULL, cmd, Tcl_NewStringObj ( worker->name, -1 ) );
+		Tcl_ListObjAppendElement ( NULL, cmd, messageObj ( msg ) );
+
+		if ( Tcl_EvalObjEx ( interp, cmd, TCL_EVAL_GLOBAL ) != TCL_OK )
+		{
+			Tcl_BackgroundError ( interp );
+		}
+
+		Tcl_DecrRefCount ( cmd );
+	}
+
+	return FALSE;
+}
+
+/* called in the worker thread */
+static void workerPostToGui ( Worker *worker, enum WorkerMessageType type, Tcl_Obj *obj )
+{
+	GSource *source = g_idle_source_new ();
+
+	g_source_set_callback ( source, workerDeliver, messageNew ( worker, type, obj ), messageFree );
+	g_source_attach ( source, NULL );
+	g_source_unref ( source );
+}
+
+static void workerReportError ( Worker *worker )
+{
+	Tcl_Obj *info = Tcl_GetVar2Ex ( worker->interp, "errorInfo", NULL, TCL_GLOBAL_ONLY );
+
+	workerPostToGui ( worker, MSG_ERROR, info != NULL ? info : Tcl_GetObjResult ( worker->interp ) );
+}
+
+static void workerHandle ( Worker *worker, WorkerMessage *msg )
+{
+	Tcl_Obj *cmd = Tcl_DuplicateObj ( worker->handler );
+
+	Tcl_IncrRefCount ( cmd );
+	Tcl_ListObjAppendElement ( NULL, cmd, messageObj ( msg ) );
+
+	if ( Tcl_EvalObjEx ( worker->interp, cmd, TCL_EVAL_GLOBAL ) != TCL_OK )
+	{
+		workerReportError ( worker );
+	}
+
+	Tcl_DecrRefCount ( cmd );
+	messageFree ( msg );
+}
+
+/**
+\brief      Handle the messages the GUI posted so far, in order.
+\date       2026-10
+**/
+static void workerDrain ( Worker *worker )
+{
+	WorkerMessage *msg;
+
+	while ( !worker->quit && ( msg = g_async_queue_try_pop ( worker->inbox ) ) != NULL )
+	{
+		if ( msg->type == MSG_QUIT )
+		{
+			worker->quit = 1;
+			messageFree ( msg );
+		}
+
+		else
+		{
+			g_queue_push_tail ( worker->pending, msg );
+		}
+	}
+
+	while ( !worker->quit && worker->handler != NULL
+			&& ( msg = g_queue_pop_head ( worker->pending ) ) != NULL )
+	{
+		workerHandle ( worker, msg );
+	}
+}
+
+static int workerEventProc ( Tcl_Event *ev, int flags )
+{
+	workerDrain ( ( ( WorkerEvent * ) ev )->worker );
+	return 1;
+}
+
+static int workerEventMatch ( Tcl_Event *ev, ClientData data )
+{
+	return ev->proc == workerEventProc && ( ( WorkerEvent * ) ev )->worker == data;
+}
+
+/* wake the worker thread, the workers lock is held */
+static void workerAlertLocked ( Worker *worker )
+{
+	WorkerEvent *ev;
+
+	/* otherwise the worker drains its inbox once its script has run */
+	if ( !worker->running )
+	{
+		return;
+	}
+
+	ev = ( WorkerEvent * ) ckalloc ( sizeof ( WorkerEvent ) );
+	ev->header.proc = workerEventProc;
+	ev->worker = worker;
+	Tcl_ThreadQueueEvent ( worker->thread, &ev->header, TCL_QUEUE_TAIL );
+	Tcl_ThreadAlert ( worker->thread );
+}
+
+static void workerAlert ( Worker *worker )
+{
+	G_LOCK ( workers );
+	workerAlertLocked ( worker );
+	G_UNLOCK ( workers );
+}
+
+/**
+\brief      Queue a message for the worker, FALSE if it has already exited.
+\date       2026-10
+\note       Messages hold a reference to their worker, none may be left in
+            the inbox of a finished worker.
+**/
+static gboolean workerSend ( Worker *worker, enum WorkerMessageType type, Tcl_Obj *obj )
+{
+	gboolean ret = FALSE;
+
+	G_LOCK ( workers );
+
+	if ( !worker->finished )
+	{
+		g_async_queue_push ( worker->inbox, messageNew ( worker, type, obj ) );
+		workerAlertLocked ( worker );
+		ret = TRUE;
+	}
+
+	G_UNLOCK ( workers );
+
+	return ret;
+}
+
+/**
+\brief      gnocl::worker inside a worker interpreter
+\date       2026-10
+**/
+static int workerThreadCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	static const char *cmds[] = { "post", "onMessage", "exit", NULL };
+	enum cmdIdx { PostIdx, OnMessageIdx, ExitIdx };
+	Worker *worker = data;
+	int idx;
+
+	if ( objc < 2 )
+	{
+		Tcl_WrongNumArgs ( interp, 1, objv, "command ?arg?" );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_GetIndexFromObj ( interp, objv[1], cmds, "command", TCL_EXACT, &idx ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	switch ( idx )
+	{
+		case PostIdx:
+			{
+				if ( objc != 3 )
+				{
+					Tcl_WrongNumArgs ( interp, 2, objv, "message" );
+					return TCL_ERROR;
+				}
+
+				workerPostToGui ( worker, MSG_STRING, objv[2] );
+			}
+			break;
+		case OnMessageIdx:
+			{
+				if ( objc > 3 )
+				{
+					Tcl_WrongNumArgs ( interp, 2, objv, "?command?" );
+					return TCL_ERROR;
+				}
+
+				if ( objc == 2 )
+				{
+					if ( worker->handler != NULL )
+					{
+						Tcl_SetObjResult ( interp, worker->handler );
+					}
+
+					return TCL_OK;
+				}
+
+				if ( worker->handler != NULL )
+				{
+					Tcl_DecrRefCount ( worker->handler );
+					worker->handler = NULL;
+				}
+
+				if ( *Tcl_GetString ( objv[2] ) != '\0' )
+				{
+					worker->handler = objv[2];
+					Tcl_IncrRefCount ( worker->handler );
+
+					/* deliver what arrived before, once the current script returns */
+					workerAlert ( worker );
+				}
+			}
+			break;
+		case ExitIdx:
+			{
+				worker->quit = 1;
+			}
+			break;
+	}
+
+	return TCL_OK;
+}
+
+/**
+\brief      Pool thread function: create the interpreter, run the script,
+            serve messages until deleted.
+\date       2026-10
+**/
+static void workerRun ( gpointer data, gpointer user_data )
+{
+	Worker *worker = data;
+	WorkerMessage *msg;
+
+	worker->interp = Tcl_CreateInterp ();
+	worker->pending = g_queue_new ();
+	Tcl_CreateObjCommand ( worker->interp, "gnocl::worker", workerThreadCmd, worker, NULL );
+
+	if ( Tcl_Init ( worker->interp ) != TCL_OK
+			|| Tcl_EvalEx ( worker->interp, worker->script, -1, TCL_EVAL_GLOBAL ) != TCL_OK )
+	{
+		workerReportError ( worker );
+		worker->quit = 1;
+	}
+
+	G_LOCK ( workers );
+	worker->thread = Tcl_GetCurrentThread ();
+	worker->running = 1;
+	G_UNLOCK ( workers );
+
+	workerDrain ( worker );
+
+	while ( !worker->quit )
+	{
+		Tcl_DoOneEvent ( TCL_ALL_EVENTS );
+	}
+
+	G_LOCK ( workers );
+	worker->running = 0;
+	worker->finished = 1;
+	G_UNLOCK ( workers );
+
+	/* this pool thread may serve another worker next */
+	Tcl_DeleteEvents ( workerEventMatch, worker );
+
+	if ( worker->handler != NULL )
+	{
+		Tcl_DecrRefCount ( worker->handler );
+	}
+
+	Tcl_DeleteInterp ( worker->interp );
+	worker->interp = NULL;
+
+	while ( ( msg = g_queue_pop_head ( worker->pending ) ) != NULL )
+	{
+		messageFree ( msg );
+	}
+
+	while ( ( msg = g_async_queue_try_pop ( worker->inbox ) ) != NULL )
+	{
+		messageFree ( msg );
+	}
+
+	g_queue_free ( worker->pending );
+	workerUnref ( worker );
+}
+
+static Worker *workerFind ( Tcl_Interp *interp, Tcl_Obj *obj )
+{
+	Worker *worker = NULL;
+
+	if ( name2worker != NULL )
+	{
+		worker = g_hash_table_lookup ( name2worker, Tcl_GetString ( obj ) );
+	}
+
+	if ( worker == NULL )
+	{
+		Tcl_AppendResult ( interp, "GNOCL ERROR: unknown worker \"", Tcl_GetString ( obj ), "\"", ( char * ) NULL );
+	}
+
+	return worker;
+}
+
+static int workerCreate ( Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	GnoclOption options[] =
+	{
+		{ "-onMessage", GNOCL_OBJ, NULL },
+		{ NULL }
+	};
+	Worker *worker;
+	GError *error = NULL;
+
+	if ( objc < 3 )
+	{
+		Tcl_WrongNumArgs ( interp, 2, objv, "script ?-onMessage command?" );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_GetVar2 ( interp, "tcl_platform", "threaded", TCL_GLOBAL_ONLY ) == NULL )
+	{
+		Tcl_SetResult ( interp, "GNOCL ERROR: workers need a threaded Tcl.", TCL_STATIC );
+		return TCL_ERROR;
+	}
+
+	if ( gnoclParseOptions ( interp, objc - 2, objv + 2, options ) != TCL_OK )
+	{
+		gnoclClearOptions ( options );
+		return TCL_ERROR;
+	}
+
+	if ( workerPool == NULL )
+	{
+		workerPool = g_thread_pool_new ( workerRun, NULL, -1, FALSE, &error );
+
+		if ( workerPool == NULL )
+		{
+			Tcl_AppendResult ( interp, "GNOCL ERROR: ", error->message, ( char * ) NULL );
+			g_error_free ( error );
+			gnoclClearOptions ( options );
+			return TCL_ERROR;
+		}
+
+		name2worker = g_hash_table_new ( g_str_hash, g_str_equal );
+		byteArrayType = Tcl_GetObjType ( "bytearray" );
+	}
+
+	worker = g_new0 ( Worker, 1 );
+	worker->refCount = 2;           /* the GUI's name and the worker thread */
+	worker->name = g_strdup_printf ( "::gnocl::_worker%d", ++workerCount );
+	worker->script = g_strdup ( Tcl_GetString ( objv[2] ) );
+	worker->guiInterp = interp;
+	worker->inbox = g_async_queue_new ();
+
+	if ( options[0].status == GNOCL_STATUS_CHANGED && *Tcl_GetString ( options[0].val.obj ) != '\0' )
+	{
+		worker->onMessage = options[0].val.obj;
+		Tcl_IncrRefCount ( worker->onMessage );
+	}
+
+	gnoclClearOptions ( options );
+
+	g_hash_table_insert ( name2worker, worker->name, worker );
+	g_thread_pool_push ( workerPool, worker, NULL );
+
+	Tcl_SetObjResult ( interp, Tcl_NewStringObj ( worker->name, -1 ) );
+
+	return TCL_OK;
+}
+
+/**
+\brief      gnocl::worker create|post|delete
+\date       2026-10
+\note       Worker data never touches name2widgetList or the option tables,
+            gnocl itself stays a GUI thread only library.
+**/
+int gnoclWorkerCmd ( ClientData data, Tcl_Interp *interp, int objc, Tcl_Obj * const objv[] )
+{
+	static const char *cmds[] = { "create", "post", "delete", NULL };
+	enum cmdIdx { CreateIdx, PostIdx, DeleteIdx };
+	Worker *worker;
+	int idx;
+
+	if ( objc < 2 )
+	{
+		Tcl_WrongNumArgs ( interp, 1, objv, "command ?arg ...?" );
+		return TCL_ERROR;
+	}
+
+	if ( Tcl_GetIndexFromObj ( interp, objv[1], cmds, "command", TCL_EXACT, &idx ) != TCL_OK )
+	{
+		return TCL_ERROR;
+	}
+
+	switch ( idx )
+	{
+		case CreateIdx:
+			return workerCreate ( interp, objc, objv );
+		case PostIdx:
+			{
+				if ( objc != 4 )
+				{
+					Tcl_WrongNumArgs ( interp, 2, objv, "id message" );
+					return TCL_ERROR;
+				}
+
+				if ( ( worker = workerFind ( interp, objv[2] ) ) == NULL )
+				{
+					return TCL_ERROR;
+				}
+
+				if ( !workerSend ( worker, MSG_STRING, objv[3] ) )
+				{
+					Tcl_AppendResult ( interp, "GNOCL ERROR: worker \"", worker->name, "\" has exited", ( char * ) NULL );
+					return TCL_ERROR;
+				}
+			}
+			break;
+		case DeleteIdx:
+			{
+				if ( objc != 3 )
+				{
+					Tcl_WrongNumArgs ( interp, 2, objv, "id" );
+					return TCL_ERROR;
+				}
+
+				if ( ( worker = workerFind ( interp, objv[2] ) ) == NULL )
+				{
+					return TCL_ERROR;
+				}
+
+				g_hash_table_remove ( name2worker, worker->name );
+				worker->deleted = 1;
+
+				if ( worker->onMessage != NULL )
+				{
+					Tcl_DecrRefCount ( worker->onMessage );
+					worker->onMessage = NULL;
+				}
+
+				workerSend ( worker, MSG_QUIT, NULL );
+				workerUnref ( worker );
+			}
+			break;
+	}
+
+	return TCL_OK;
+}